@@ -26,6 +26,19 @@ typedef struct csmModel csmModel;
 typedef unsigned short csmHash;
 
 
+/// Allocation function.
+///
+/// @param  size  Number of bytes to allocate.
+///
+/// @return  Valid address to allocated memory on success; '0' otherwise.
+typedef void* (*csmAllocateFunction)(const unsigned int size);
+
+/// Deallocation function.
+///
+/// @param  memory  Address of memory block to free.
+typedef void (*csmDeallocateFunction)(void* memory);
+
+
 /// Look up table.
 typedef struct csmModelHashTable
 {
@@ -72,10 +85,49 @@ float csmOverrideFloatBlendFunction(float base, float value, float weight);
 /// Builtin additive float blend function.
 float csmAdditiveFloatBlendFunction(float base, float value, float weight);
 
+/// Builtin multiplicative float blend function.
+float csmMultiplicativeFloatBlendFunction(float base, float value, float weight);
+
+/// Builtin weighted lerp float blend function.
+float csmLerpFloatBlendFunction(float base, float value, float weight);
+
 
 /// Opaque Cubism animation.
 typedef struct csmAnimation csmAnimation;
 
+/// Opaque animation bound to a model.
+typedef struct csmAnimationBinding csmAnimationBinding;
+
+/// Opaque set of parameters and parts to restrict animation bindings to.
+typedef struct csmAnimationMask csmAnimationMask;
+
+/// Opaque per-curve segment cache of a playing animation.
+typedef struct csmAnimationCursor csmAnimationCursor;
+
+/// Opaque struct-of-arrays view of an animation.
+typedef struct csmAnimationView csmAnimationView;
+
+/// Opaque animation resampled at a fixed rate.
+typedef struct csmBakedAnimation csmBakedAnimation;
+
+/// Opaque lossy compressed animation.
+typedef struct csmCompressedAnimation csmCompressedAnimation;
+
+/// Opaque per-curve key cache of a playing compressed animation.
+typedef struct csmCompressedAnimationCursor csmCompressedAnimationCursor;
+
+/// Opaque mixer for blending several animations into a model at once.
+typedef struct csmAnimationMixer csmAnimationMixer;
+
+/// Opaque cache of evaluated animation curves shared by instances.
+typedef struct csmAnimationEvaluationCache csmAnimationEvaluationCache;
+
+/// Opaque memory-budgeted set of deserialized animations.
+typedef struct csmAnimationLibrary csmAnimationLibrary;
+
+/// Opaque pool of curves shared by animations.
+typedef struct csmAnimationCurvePool csmAnimationCurvePool;
+
 
 /// Play state of an animation.
 typedef struct csmAnimationState
@@ -86,6 +138,93 @@ typedef struct csmAnimationState
 csmAnimationState;
 
 
+/// Statistics of a compressed animation.
+typedef struct csmAnimationCompressionReport
+{
+  /// Size of source animation (in bytes).
+  unsigned int SourceSize;
+
+  /// Size of compressed animation (in bytes).
+  unsigned int CompressedSize;
+
+  /// Source size divided by compressed size.
+  float Ratio;
+
+  /// Maximum difference to source over all curves.
+  float MaxError;
+
+  /// Seconds per quantized time step (keys may move by half of it).
+  float TimeResolution;
+
+  /// Number of curves.
+  int CurveCount;
+}
+csmAnimationCompressionReport;
+
+
+/// Statistics of an animation library.
+typedef struct csmAnimationLibraryStatistics
+{
+  /// Number of lookups that found their animation.
+  unsigned int HitCount;
+
+  /// Number of lookups that didn't find their animation.
+  unsigned int MissCount;
+
+  /// Number of animations evicted to make room.
+  unsigned int EvictionCount;
+
+  /// Number of resident animations.
+  int AnimationCount;
+
+  /// Number of arena bytes taken by resident animations.
+  unsigned int UsedSize;
+
+  /// Size of arena (in bytes).
+  unsigned int ArenaSize;
+}
+csmAnimationLibraryStatistics;
+
+
+/// Statistics of an animation curve pool.
+typedef struct csmAnimationCurvePoolStatistics
+{
+  /// Number of pooled animations.
+  int AnimationCount;
+
+  /// Number of curves of all pooled animations.
+  int CurveCount;
+
+  /// Number of curves stored (the rest reference identical curves).
+  int UniqueCurveCount;
+
+  /// Number of bytes pooled animations took before pooling.
+  unsigned int SourceSize;
+
+  /// Number of bytes pooled animations and their unique curves take.
+  unsigned int PooledSize;
+}
+csmAnimationCurvePoolStatistics;
+
+
+/// Animation blend mode.
+typedef enum csmAnimationBlendMode
+{
+  /// Weighted value replaces current value (like 'csmOverrideFloatBlendFunction').
+  csmOverrideAnimationBlend,
+
+  /// Weighted value is added to current value (like 'csmAdditiveFloatBlendFunction').
+  csmAdditiveAnimationBlend,
+
+  /// Current value is scaled by value lerped from '1' by weight (like 'csmMultiplicativeFloatBlendFunction').
+  csmMultiplicativeAnimationBlend,
+
+  /// Current value is lerped towards value by weight (like 'csmLerpFloatBlendFunction').
+  csmLerpAnimationBlend
+}
+csmAnimationBlendMode;
+
+
 /// Animation model curve type.
 typedef enum csmModelAnimationCurveType
 {
@@ -110,6 +249,30 @@ csmModelAnimationCurveType;
 typedef void csmModelAnimationCurveHandler(const csmModel* model, const csmModelAnimationCurveType type, const float value, void* userData);
 
 
+/// Layer of an animation mixer.
+typedef struct csmAnimationMixerLayer
+{
+  /// Animation to evaluate.
+  const csmAnimation* Animation;
+
+  /// Binding of animation to model.
+  const csmAnimationBinding* Binding;
+
+  /// [Optional] Cursor of animation to use and update.
+  csmAnimationCursor* Cursor;
+
+  /// Animation state.
+  const csmAnimationState* State;
+
+  /// Blend weight factor.
+  float Weight;
+
+  /// Blend mode.
+  csmAnimationBlendMode BlendMode;
+}
+csmAnimationMixerLayer;
+
+
 // ------- //
 // PHYSICS //
 // ------- //
@@ -234,9 +397,17 @@ void csmUpdateAnimationState(csmAnimationState* state, const float deltaTime);
 ///
 /// @param  motionJson  Serialized animation to query for.
 ///
-/// @return  Number of bytes necessary.
+/// @return  Number of bytes necessary; '0' if motion JSON is invalid.
 unsigned int csmGetDeserializedSizeofAnimation(const char* motionJsonString);
 
+/// Gets the deserialized size of a serialized animation of known length in bytes.
+///
+/// @param  motionJson  Serialized animation to query for (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+///
+/// @return  Number of bytes necessary; '0' if motion JSON is invalid.
+unsigned int csmGetDeserializedSizeofAnimationWithLength(const char* motionJson, const unsigned int length);
+
 
 /// Deserializes an animotion.
 ///
@@ -247,6 +418,138 @@ unsigned int csmGetDeserializedSizeofAnimation(const char* motionJsonString);
 /// @return  Valid pointer on success; '0' otherwise.
 csmAnimation *csmDeserializeAnimationInPlace(const char *motionJson, void* address, const unsigned int size);
 
+/// Deserializes an animation of known length.
+///
+/// @param  motionJson  Serialized animation (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+/// @param  address     Address to place deserialized animation at.
+/// @param  size        Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimation* csmDeserializeAnimationInPlaceWithLength(const char* motionJson,
+                                                       const unsigned int length,
+                                                       void* address,
+                                                       const unsigned int size);
+
+/// Deserializes an animation lexing the serialized animation only once.
+/// Both animation memory and temporary memory are requested through the functions passed.
+///
+/// @param  motionJson  Serialized animation.
+/// @param  allocate    Function to allocate memory with.
+/// @param  deallocate  Function to free temporary memory with.
+///
+/// @return  Valid pointer on success; '0' otherwise. Free the animation with the counterpart of 'allocate'.
+csmAnimation* csmDeserializeAnimation(const char* motionJson,
+                                      csmAllocateFunction allocate,
+                                      csmDeallocateFunction deallocate);
+
+/// Deserializes an animation of known length lexing it only once.
+///
+/// @param  motionJson  Serialized animation (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+/// @param  allocate    Function to allocate memory with.
+/// @param  deallocate  Function to free temporary memory with.
+///
+/// @return  Valid pointer on success; '0' otherwise. Free the animation with the counterpart of 'allocate'.
+csmAnimation* csmDeserializeAnimationWithLength(const char* motionJson,
+                                                const unsigned int length,
+                                                csmAllocateFunction allocate,
+                                                csmDeallocateFunction deallocate);
+
+
+/// Gets the size of a lazily deserialized animation in bytes.
+///
+/// @param  motionJson  Serialized animation to query for (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+///
+/// @return  Number of bytes necessary; '0' if motion JSON is invalid.
+unsigned int csmGetLazyDeserializedSizeofAnimationWithLength(const char* motionJson, const unsigned int length);
+
+/// Deserializes an animation lazily.
+///
+/// Only curve headers are read right away; the segments of each curve are decoded the first time the curve is evaluated.
+/// The serialized animation has to outlive the animation until all curves are decoded,
+/// and evaluating the animation isn't thread-safe until then.
+/// Views, compression, and serialization take fully decoded animations only (see 'csmDecodeAnimation()').
+///
+/// @param  motionJson  Serialized animation (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+/// @param  address     Address to place deserialized animation at (aligned to pointer size).
+/// @param  size        Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimation* csmDeserializeAnimationLazilyInPlaceWithLength(const char* motionJson,
+                                                             const unsigned int length,
+                                                             void* address,
+                                                             const unsigned int size);
+
+/// Decodes all curves of a lazily deserialized animation that aren't decoded yet.
+///
+/// @param  animation  Animation to decode.
+void csmDecodeAnimation(csmAnimation* animation);
+
+/// Checks whether all curves of an animation are decoded.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Non-zero if all curves are decoded (and the serialized animation isn't needed anymore); '0' otherwise.
+int csmIsAnimationDecoded(const csmAnimation* animation);
+
+
+/// Converts an animation into an additive one relative to the default parameter values of a model.
+///
+/// Parameter curves have the default value of their parameter subtracted, so that blending the animation with 'csmAdditiveAnimationBlend'
+/// moves parameters away from wherever other layers put them instead of adding absolute values.
+/// Part opacity and model curves are kept as is.
+/// Views, baked, compressed, and pooled copies have to be made after converting.
+///
+/// @param  animation  Fully decoded animation to convert in place.
+/// @param  model      Model providing default values.
+void csmMakeAnimationAdditiveToModel(csmAnimation* animation, const csmModel* model);
+
+/// Converts an animation into an additive one relative to a pose of a reference animation.
+///
+/// Parameter and part opacity curves have the value of the matching reference curve at the reference time subtracted.
+/// Curves the reference doesn't animate (or all curves if no reference is passed) are made relative to their own value at the reference time.
+/// Model curves are kept as is.
+/// Views, baked, compressed, and pooled copies have to be made after converting.
+///
+/// @param  animation      Fully decoded animation to convert in place.
+/// @param  reference      [Optional] Animation providing reference pose.
+/// @param  referenceTime  Time to take reference pose at (e.g. '0' for the first frame).
+void csmMakeAnimationAdditiveToAnimation(csmAnimation* animation, const csmAnimation* reference, const float referenceTime);
+
+
+/// Gets the serialized size of an animation in bytes.
+///
+/// @param  animation  Animation to query for.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSerializedSizeofAnimation(const csmAnimation* animation);
+
+/// Serializes an animation into a relocatable blob that can be stored and loaded with 'csmLoadAnimationFromBlob'.
+///
+/// Blobs can only be loaded on platforms with the same byte order.
+///
+/// @param  animation  Animation to serialize.
+/// @param  address    Address to write blob to.
+/// @param  size       Size of passed memory block (in bytes).
+///
+/// @return  Number of bytes written on success; '0' otherwise.
+unsigned int csmSerializeAnimation(const csmAnimation* animation, void* address, const unsigned int size);
+
+/// Loads an animation from a serialized blob.
+///
+/// The animation is used in place without parsing or copying,
+/// so the blob has to outlive the animation (and has to be aligned to 4 bytes).
+/// Only the blob layout is validated (not every single segment), so only load blobs from trusted sources.
+///
+/// @param  blob  Serialized animation (e.g. a memory-mapped file).
+/// @param  size  Size of blob (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+const csmAnimation* csmLoadAnimationFromBlob(const void* blob, const unsigned int size);
+
 
 /// Evaluates an animation fast by using a hash table for look-ups.
 ///
@@ -267,6 +570,574 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
                               csmModelAnimationCurveHandler handleModelCurve,
                               void* userData);
 
+
+/// Gets the size of an animation binding in bytes.
+///
+/// @param  animation  Animation to bind.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationBinding(const csmAnimation* animation);
+
+/// Binds an animation to a model by resolving curve targets once.
+///
+/// @param  animation  Animation to bind.
+/// @param  table      Hash table of model to bind to.
+/// @param  address    Address to place binding at.
+/// @param  size       Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationBinding* csmBindAnimationInPlace(const csmAnimation* animation,
+                                             const csmModelHashTable* table,
+                                             void* address,
+                                             const unsigned int size);
+
+/// Binds an animation to a model by resolving curve targets once.
+///
+/// @param  animation  Animation to bind.
+/// @param  table      Hash table of model to bind to.
+/// @param  allocate   Function to allocate memory with.
+///
+/// @return  Valid pointer on success; '0' otherwise. Free the binding with the counterpart of 'allocate'.
+csmAnimationBinding* csmBindAnimation(const csmAnimation* animation, const csmModelHashTable* table, csmAllocateFunction allocate);
+
+
+/// Gets the size of an animation mask in bytes.
+///
+/// @param  model  Model to create mask for.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationMask(const csmModel* model);
+
+/// Initializes an empty animation mask.
+///
+/// @param  model    Model to create mask for.
+/// @param  address  Address to place mask at (aligned to 8 bytes).
+/// @param  size     Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationMask* csmInitializeAnimationMaskInPlace(const csmModel* model, void* address, const unsigned int size);
+
+/// Adds a parameter to or removes it from a mask.
+///
+/// @param  mask            Mask to update.
+/// @param  parameterIndex  Index of parameter.
+/// @param  isIncluded      Non-zero to add parameter; '0' to remove it.
+void csmSetAnimationMaskParameter(csmAnimationMask* mask, const int parameterIndex, const int isIncluded);
+
+/// Adds a part to or removes it from a mask.
+///
+/// @param  mask        Mask to update.
+/// @param  partIndex   Index of part.
+/// @param  isIncluded  Non-zero to add part; '0' to remove it.
+void csmSetAnimationMaskPart(csmAnimationMask* mask, const int partIndex, const int isIncluded);
+
+/// Restricts a binding to the parameters and parts of a mask.
+///
+/// Parameter and part opacity curves targeting values outside the mask are dropped from the binding once,
+/// so that every evaluation through the binding skips them without testing the mask (model curves are kept).
+/// Bind the animation again to undo masking.
+///
+/// @param  binding  Binding to restrict in place.
+/// @param  mask     Mask created for model binding is bound to.
+void csmMaskAnimationBinding(csmAnimationBinding* binding, const csmAnimationMask* mask);
+
+
+/// Gets the size of an animation cursor in bytes.
+///
+/// @param  animation  Animation to track.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationCursor(const csmAnimation* animation);
+
+/// Initializes an animation cursor.
+///
+/// Use one cursor per playing animation (alongside its 'csmAnimationState')
+/// so that forward playback finds segments to evaluate without searching.
+///
+/// @param  animation  Animation to track.
+/// @param  address    Address to place cursor at.
+/// @param  size       Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationCursor* csmInitializeAnimationCursorInPlace(const csmAnimation* animation, void* address, const unsigned int size);
+
+
+/// Evaluates an animation through a binding without any look-ups.
+///
+/// @param  animation         Animation to evaluate.
+/// @param  binding           Binding of animation to model.
+/// @param  cursor            [Optional] Cursor of animation to use and update.
+/// @param  state             Animation state.
+/// @param  blend             Blend function to use for filling sink.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model animation is bound to.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateBoundAnimation(const csmAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               csmAnimationCursor* cursor,
+                               const csmAnimationState* state,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData);
+
+
+/// Gets the number of values a bound animation evaluates to.
+///
+/// @param  binding  Binding to query.
+///
+/// @return  Number of values.
+int csmGetBoundAnimationValueCount(const csmAnimationBinding* binding);
+
+/// Evaluates a bound animation into a value buffer (first phase of blending in two phases).
+///
+/// Values are ordered like the bound curves (model curves, followed by parameter and part opacity curves).
+///
+/// @param  animation  Animation to evaluate.
+/// @param  binding    Binding of animation to model.
+/// @param  cursor     [Optional] Cursor of animation to use and update.
+/// @param  state      Animation state.
+/// @param  values     Buffer with room for 'csmGetBoundAnimationValueCount()' values.
+void csmEvaluateBoundAnimationValues(const csmAnimation* animation,
+                                     const csmAnimationBinding* binding,
+                                     csmAnimationCursor* cursor,
+                                     const csmAnimationState* state,
+                                     float* values);
+
+/// Blends evaluated values into a model (second phase of blending in two phases).
+///
+/// Values are blended several at once where vector instructions are available.
+/// Use 'csmEvaluateBoundAnimation()' for custom blend functions.
+///
+/// @param  binding           Binding values were evaluated with.
+/// @param  values            Values to blend.
+/// @param  blendMode         Blend mode.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model to blend values into.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmBlendBoundAnimationValues(const csmAnimationBinding* binding,
+                                  const float* values,
+                                  const csmAnimationBlendMode blendMode,
+                                  const float weight,
+                                  csmModel* model,
+                                  csmModelAnimationCurveHandler handleModelCurve,
+                                  void* userData);
+
+
+/// Evaluates an animation on many model instances at once.
+///
+/// Curves are walked once per batch of instances, evaluating all instances per curve while curve data is in cache.
+/// Instances must be instances of the model the binding was created for.
+/// Instances sorted by time look up segments faster.
+///
+/// @param  animation         Animation to evaluate.
+/// @param  binding           Binding of animation to models.
+/// @param  states            Animation states (one per instance).
+/// @param  models            Models to evaluate into (one per instance).
+/// @param  count             Number of instances.
+/// @param  blend             Blend function to use for filling sinks.
+/// @param  weight            Blend weight factor.
+/// @param  handleModelCurve  [Optional] Model curve handler (called per instance).
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateAnimationBatch(const csmAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               const csmAnimationState* states,
+                               csmModel* const* models,
+                               const int count,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData);
+
+
+/// Gets the size of an animation view in bytes.
+///
+/// @param  animation  Animation to view.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationView(const csmAnimation* animation);
+
+/// Initializes a struct-of-arrays view of an animation.
+///
+/// Like animations, views are read-only while evaluating, so a single view can be shared by all models playing the animation.
+///
+/// @param  animation  Animation to view.
+/// @param  address    Address to place view at.
+/// @param  size       Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationView* csmInitializeAnimationViewInPlace(const csmAnimation* animation, void* address, const unsigned int size);
+
+/// Evaluates an animation through its view, evaluating multiple curves per instruction where supported.
+///
+/// Results are bit-identical to 'csmEvaluateBoundAnimation' (as long as the compiler doesn't contract floating-point operations).
+///
+/// @param  animation         Animation to evaluate.
+/// @param  view              View of animation.
+/// @param  binding           Binding of animation to model.
+/// @param  cursor            [Optional] Cursor of animation to use and update.
+/// @param  state             Animation state.
+/// @param  blend             Blend function to use for filling sink.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model animation is bound to.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateAnimationView(const csmAnimation* animation,
+                              const csmAnimationView* view,
+                              const csmAnimationBinding* binding,
+                              csmAnimationCursor* cursor,
+                              const csmAnimationState* state,
+                              const csmFloatBlendFunction blend,
+                              const float weight,
+                              csmModel* model,
+                              csmModelAnimationCurveHandler handleModelCurve,
+                              void* userData);
+
+
+/// Gets the size of a baked animation in bytes.
+///
+/// @param  animation   Animation to bake.
+/// @param  sampleRate  Samples per second (or '0' for the rate the motion was authored at).
+/// @param  quantize    Non-zero to store samples as 16-bit values relative to the value range of each curve.
+///
+/// @return  Number of bytes necessary on success; '0' otherwise.
+unsigned int csmGetSizeofBakedAnimation(const csmAnimation* animation, const float sampleRate, const int quantize);
+
+/// Resamples all curves of an animation at a fixed rate.
+///
+/// Evaluating baked animations interpolates linearly between two samples without searching segments,
+/// trading memory (and precision between samples) for constant evaluation cost.
+/// Baked animations are self-contained and relocatable, so the animation can be released afterwards.
+///
+/// @param  animation   Animation to bake.
+/// @param  sampleRate  Samples per second (or '0' for the rate the motion was authored at).
+/// @param  quantize    Non-zero to store samples as 16-bit values relative to the value range of each curve.
+/// @param  address     Address to place baked animation at.
+/// @param  size        Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmBakedAnimation* csmBakeAnimationInPlace(const csmAnimation* animation,
+                                           const float sampleRate,
+                                           const int quantize,
+                                           void* address,
+                                           const unsigned int size);
+
+/// Evaluates a baked animation.
+///
+/// @param  animation         Baked animation to evaluate.
+/// @param  binding           Binding of animation baked animation was baked from.
+/// @param  state             Animation state.
+/// @param  blend             Blend function to use for filling sink.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model animation is bound to.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateBakedAnimation(const csmBakedAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               const csmAnimationState* state,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData);
+
+
+/// Gets the size of an animation mixer in bytes.
+///
+/// @param  model  Model to mix animations into.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationMixer(const csmModel* model);
+
+/// Initializes an animation mixer.
+///
+/// @param  model    Model to mix animations into.
+/// @param  address  Address to place mixer at.
+/// @param  size     Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationMixer* csmInitializeAnimationMixerInPlace(const csmModel* model, void* address, const unsigned int size);
+
+/// Evaluates animation layers into a model in one pass.
+///
+/// Layers are accumulated first, and each parameter and part opacity is written once afterwards.
+/// Blend modes apply in fixed order (independent of layer order):
+/// Override layers and then lerp layers are averaged by weight if their weights sum up to more than '1',
+/// multiplicative layers scale the result, and additive layers are added on top.
+/// Model curves are passed to the handler per layer.
+///
+/// @param  mixer             Mixer to use.
+/// @param  layers            Layers to evaluate.
+/// @param  layerCount        Number of layers.
+/// @param  model             Model to write to (the one mixer was initialized for).
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateAnimationMixer(csmAnimationMixer* mixer,
+                               const csmAnimationMixerLayer* layers,
+                               const int layerCount,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData);
+
+
+/// Gets the size of an animation evaluation cache in bytes.
+///
+/// @param  curveCount  Maximum number of curves of cached animations.
+/// @param  entryCount  Number of playheads to cache.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationEvaluationCache(const int curveCount, const int entryCount);
+
+/// Initializes an animation evaluation cache.
+///
+/// @param  curveCount      Maximum number of curves of cached animations.
+/// @param  entryCount      Number of playheads to cache.
+/// @param  timeResolution  Resolution times are quantized to (or '0' for caching exact times only).
+/// @param  address         Address to place cache at.
+/// @param  size            Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationEvaluationCache* csmInitializeAnimationEvaluationCacheInPlace(const int curveCount,
+                                                                          const int entryCount,
+                                                                          const float timeResolution,
+                                                                          void* address,
+                                                                          const unsigned int size);
+
+/// Drops all cached values (e.g. before releasing cached animations).
+///
+/// @param  cache  Cache to reset.
+void csmResetAnimationEvaluationCache(csmAnimationEvaluationCache* cache);
+
+/// Drops cached values of an animation (e.g. before releasing it, as entries are keyed by address).
+///
+/// @param  cache      Cache to update.
+/// @param  animation  Animation to drop values of.
+void csmDropCachedAnimationValues(csmAnimationEvaluationCache* cache, const csmAnimation* animation);
+
+/// Gets cached curve values of an animation, evaluating the animation on a cache miss.
+///
+/// Playheads are quantized to the time resolution of the cache, and the least recently added playhead is dropped if the cache is full.
+///
+/// @param  cache      Cache to use.
+/// @param  animation  Animation to evaluate.
+/// @param  state      Animation state.
+///
+/// @return  Values indexed by curve on success (valid until the next cache miss); '0' otherwise.
+const float* csmGetCachedAnimationValues(csmAnimationEvaluationCache* cache,
+                                         const csmAnimation* animation,
+                                         const csmAnimationState* state);
+
+/// Evaluates an animation through a binding, sharing evaluated values with all instances at the same playhead.
+///
+/// @param  cache             Cache to use.
+/// @param  animation         Animation to evaluate.
+/// @param  binding           Binding of animation to model.
+/// @param  state             Animation state.
+/// @param  blend             Blend function to use for filling sink.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model animation is bound to.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateCachedAnimation(csmAnimationEvaluationCache* cache,
+                                const csmAnimation* animation,
+                                const csmAnimationBinding* binding,
+                                const csmAnimationState* state,
+                                const csmFloatBlendFunction blend,
+                                const float weight,
+                                csmModel* model,
+                                csmModelAnimationCurveHandler handleModelCurve,
+                                void* userData);
+
+
+/// Gets the size of an animation library in bytes.
+///
+/// @param  entryCount  Maximum number of resident animations.
+/// @param  arenaSize   Memory budget for deserialized animations (in bytes).
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationLibrary(const int entryCount, const unsigned int arenaSize);
+
+/// Initializes an animation library.
+///
+/// @param  entryCount  Maximum number of resident animations.
+/// @param  arenaSize   Memory budget for deserialized animations (in bytes).
+/// @param  address     Address to place library at (aligned to pointer size).
+/// @param  size        Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationLibrary* csmInitializeAnimationLibraryInPlace(const int entryCount,
+                                                          const unsigned int arenaSize,
+                                                          void* address,
+                                                          const unsigned int size);
+
+/// Attaches an evaluation cache to a library, so that evicted animations are dropped from the cache.
+///
+/// Without this, a cache could return values of an evicted animation for an animation later loaded at the same address.
+///
+/// @param  library  Library to attach cache to.
+/// @param  cache    [Optional] Cache to drop evicted animations from ('0' to detach cache).
+void csmSetAnimationLibraryEvaluationCache(csmAnimationLibrary* library, csmAnimationEvaluationCache* cache);
+
+/// Looks up a resident animation, counting a hit or a miss.
+///
+/// Found animations become the most recently used ones.
+///
+/// @param  library  Library to search.
+/// @param  key      Key animation was loaded with.
+///
+/// @return  Animation if resident (valid until evicted); '0' otherwise.
+const csmAnimation* csmFindLibraryAnimation(csmAnimationLibrary* library, const int key);
+
+/// Deserializes an animation into a library unless it's resident already.
+///
+/// Least recently used animations are evicted until the animation fits,
+/// so animations looked up since the last load are evicted last.
+/// Lookups should go through 'csmFindLibraryAnimation()' first, which counts hits and misses.
+///
+/// @param  library     Library to load into.
+/// @param  key         Key to load animation with.
+/// @param  motionJson  Serialized animation (doesn't have to be null-terminated).
+/// @param  length      Length of serialized animation (in chars).
+///
+/// @return  Animation on success (valid until evicted); '0' otherwise.
+const csmAnimation* csmLoadLibraryAnimation(csmAnimationLibrary* library,
+                                            const int key,
+                                            const char* motionJson,
+                                            const unsigned int length);
+
+/// Queries animation library statistics.
+///
+/// @param  library     Library to query.
+/// @param  statistics  Statistics to fill.
+void csmGetAnimationLibraryStatistics(const csmAnimationLibrary* library, csmAnimationLibraryStatistics* statistics);
+
+
+/// Gets the size of an animation curve pool in bytes.
+///
+/// @param  animationCount  Maximum number of pooled animations.
+/// @param  curveCount      Maximum number of curves of all pooled animations.
+/// @param  segmentCount    Maximum number of segments of unique curves.
+/// @param  bezierCount     Maximum number of bezier segments of unique curves.
+/// @param  pointCount      Maximum number of points of unique curves.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofAnimationCurvePool(const int animationCount,
+                                            const int curveCount,
+                                            const int segmentCount,
+                                            const int bezierCount,
+                                            const int pointCount);
+
+/// Initializes an animation curve pool.
+///
+/// @param  animationCount  Maximum number of pooled animations.
+/// @param  curveCount      Maximum number of curves of all pooled animations.
+/// @param  segmentCount    Maximum number of segments of unique curves.
+/// @param  bezierCount     Maximum number of bezier segments of unique curves.
+/// @param  pointCount      Maximum number of points of unique curves.
+/// @param  address         Address to place pool at (aligned to pointer size).
+/// @param  size            Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmAnimationCurvePool* csmInitializeAnimationCurvePoolInPlace(const int animationCount,
+                                                              const int curveCount,
+                                                              const int segmentCount,
+                                                              const int bezierCount,
+                                                              const int pointCount,
+                                                              void* address,
+                                                              const unsigned int size);
+
+/// Copies an animation into a curve pool, storing each of its curves only if the pool doesn't hold a byte-identical curve yet.
+///
+/// Pooled animations evaluate exactly like their source, which can be released afterwards.
+/// They live as long as the pool, and serializing one writes the pool storage it references, too.
+///
+/// @param  pool       Pool to add animation to.
+/// @param  animation  Fully decoded animation to add.
+///
+/// @return  Pooled animation on success; '0' otherwise.
+const csmAnimation* csmAddAnimationToCurvePool(csmAnimationCurvePool* pool, const csmAnimation* animation);
+
+/// Queries animation curve pool statistics.
+///
+/// @param  pool        Pool to query.
+/// @param  statistics  Statistics to fill.
+void csmGetAnimationCurvePoolStatistics(const csmAnimationCurvePool* pool, csmAnimationCurvePoolStatistics* statistics);
+
+
+/// Compresses an animation.
+///
+/// Curves are sampled into linear keys, keys that can be interpolated from their neighbors within tolerance are dropped,
+/// flat curves are collapsed into a single key, and key times and values are quantized to 16 bits.
+/// Compressed animations are self-contained and relocatable, so the animation can be released afterwards.
+///
+/// @param  animation   Animation to compress.
+/// @param  tolerance   Maximum value difference to drop keys at.
+/// @param  allocate    Allocator to use (for compressed animation and temporary memory).
+/// @param  deallocate  Deallocator to use (for temporary memory).
+///
+/// @return  Compressed animation on success; '0' otherwise.
+csmCompressedAnimation* csmCompressAnimation(const csmAnimation* animation,
+                                             const float tolerance,
+                                             csmAllocateFunction allocate,
+                                             csmDeallocateFunction deallocate);
+
+/// Queries compression statistics.
+///
+/// Errors are measured against the source animation while compressing (including quantization errors).
+/// As key times are quantized, too, steps may move by up to half of the time resolution.
+///
+/// @param  animation    Compressed animation to query.
+/// @param  report       Report to fill.
+/// @param  curveErrors  [Optional] Buffer with room for an error per curve.
+void csmGetAnimationCompressionReport(const csmCompressedAnimation* animation,
+                                      csmAnimationCompressionReport* report,
+                                      float* curveErrors);
+
+/// Gets the size of a compressed animation cursor in bytes.
+///
+/// @param  animation  Compressed animation to track.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSizeofCompressedAnimationCursor(const csmCompressedAnimation* animation);
+
+/// Initializes a compressed animation cursor.
+///
+/// Compressed curves consist of keys instead of segments,
+/// so cursors of source animations can't be used (or shared) for evaluating compressed animations.
+///
+/// @param  animation  Compressed animation to track.
+/// @param  address    Address to place cursor at.
+/// @param  size       Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmCompressedAnimationCursor* csmInitializeCompressedAnimationCursorInPlace(const csmCompressedAnimation* animation,
+                                                                            void* address,
+                                                                            const unsigned int size);
+
+/// Evaluates a compressed animation.
+///
+/// @param  animation         Compressed animation to evaluate.
+/// @param  binding           Binding of animation compressed animation was compressed from.
+/// @param  cursor            [Optional] Cursor of compressed animation to use and update.
+/// @param  state             Animation state.
+/// @param  blend             Blend function to use for filling sink.
+/// @param  weight            Blend weight factor.
+/// @param  model             Model animation is bound to.
+/// @param  handleModelCurve  [Optional] Model curve handler.
+/// @param  userData          [Optional] Data to pass to model curve handler.
+void csmEvaluateCompressedAnimation(const csmCompressedAnimation* animation,
+                                    const csmAnimationBinding* binding,
+                                    csmCompressedAnimationCursor* cursor,
+                                    const csmAnimationState* state,
+                                    const csmFloatBlendFunction blend,
+                                    const float weight,
+                                    csmModel* model,
+                                    csmModelAnimationCurveHandler handleModelCurve,
+                                    void* userData);
+
 // ------- //
 // PHYSICS //
 // ------- //
@@ -274,8 +1145,93 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
 // TODO Document
 unsigned int csmGetDeserializedSizeofPhysics(const char *physicsJson);
 
+/// Gets the deserialized size of serialized physics of known length in bytes.
+///
+/// @param  physicsJson  Serialized physics to query for (doesn't have to be null-terminated).
+/// @param  length       Length of serialized physics (in chars).
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetDeserializedSizeofPhysicsWithLength(const char* physicsJson, const unsigned int length);
+
 // TODO Document
 csmPhysicsRig *csmDeserializePhysicsInPlace(const char *physicsJson, void* address, const unsigned int size);
 
+/// Deserializes physics of known length.
+///
+/// @param  physicsJson  Serialized physics (doesn't have to be null-terminated).
+/// @param  length       Length of serialized physics (in chars).
+/// @param  address      Address to place deserialized rig at.
+/// @param  size         Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmPhysicsRig* csmDeserializePhysicsInPlaceWithLength(const char* physicsJson,
+                                                      const unsigned int length,
+                                                      void* address,
+                                                      const unsigned int size);
+
+/// Deserializes physics lexing the serialized physics only once.
+/// Both rig memory and temporary memory are requested through the functions passed.
+///
+/// @param  physicsJson  Serialized physics.
+/// @param  allocate     Function to allocate memory with.
+/// @param  deallocate   Function to free temporary memory with.
+///
+/// @return  Valid pointer on success; '0' otherwise. Free the rig with the counterpart of 'allocate'.
+csmPhysicsRig* csmDeserializePhysics(const char* physicsJson,
+                                     csmAllocateFunction allocate,
+                                     csmDeallocateFunction deallocate);
+
+/// Deserializes physics of known length lexing it only once.
+///
+/// @param  physicsJson  Serialized physics (doesn't have to be null-terminated).
+/// @param  length       Length of serialized physics (in chars).
+/// @param  allocate     Function to allocate memory with.
+/// @param  deallocate   Function to free temporary memory with.
+///
+/// @return  Valid pointer on success; '0' otherwise. Free the rig with the counterpart of 'allocate'.
+csmPhysicsRig* csmDeserializePhysicsWithLength(const char* physicsJson,
+                                               const unsigned int length,
+                                               csmAllocateFunction allocate,
+                                               csmDeallocateFunction deallocate);
+
+
+/// Gets the serialized size of physics in bytes.
+///
+/// @param  physics  Physics to query for.
+///
+/// @return  Number of bytes necessary.
+unsigned int csmGetSerializedSizeofPhysics(const csmPhysicsRig* physics);
+
+/// Serializes physics into a blob that can be stored and loaded with 'csmLoadPhysicsFromBlobInPlace'.
+///
+/// Blobs can only be loaded on platforms with the same byte order.
+///
+/// @param  physics  Physics to serialize.
+/// @param  address  Address to write blob to.
+/// @param  size     Size of passed memory block (in bytes).
+///
+/// @return  Number of bytes written on success; '0' otherwise.
+unsigned int csmSerializePhysics(const csmPhysicsRig* physics, void* address, const unsigned int size);
+
+/// Gets the deserialized size of serialized physics blob in bytes.
+///
+/// @param  blob  Serialized physics.
+/// @param  size  Size of blob (in bytes).
+///
+/// @return  Number of bytes necessary on success; '0' otherwise.
+unsigned int csmGetDeserializedSizeofPhysicsFromBlob(const void* blob, const unsigned int size);
+
+/// Loads physics from a serialized blob without parsing.
+///
+/// Unlike animations, physics carry state, so the rig is copied out of the blob (which can be released afterwards).
+///
+/// @param  blob      Serialized physics (has to be aligned to 4 bytes).
+/// @param  blobSize  Size of blob (in bytes).
+/// @param  address   Address to place loaded rig at.
+/// @param  size      Size of passed memory block (in bytes).
+///
+/// @return  Valid pointer on success; '0' otherwise.
+csmPhysicsRig* csmLoadPhysicsFromBlobInPlace(const void* blob, const unsigned int blobSize, void* address, const unsigned int size);
+
 // TODO Document
 void csmPhysicsEvaluate(csmModel* model, csmPhysicsRig* physics, csmPhysicsOptions* options, float deltaTime);
\ No newline at end of file
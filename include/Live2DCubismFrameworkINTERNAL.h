@@ -80,6 +80,21 @@ typedef int (*csmJsonTokenHandler)(const char* jsonString,
                                    void* userData);
 
 
+/// Lexed JSON token.
+typedef struct csmJsonToken
+{
+  /// Token type.
+  csmJsonTokenType Type;
+
+  /// Begin of token as offset into string (in chars).
+  int Begin;
+
+  /// End of token as offset into string (in chars).
+  int End;
+}
+csmJsonToken;
+
+
 /// Single point making up an animation curve.
 typedef struct csmAnimationPoint
 {
@@ -108,6 +123,8 @@ float csmLinearAnimationSegmentEvaluationFunction(const csmAnimationPoint* point
 /// Builtin bezier animation segment evaluation.
 ///
 /// First 4 points are evaluated.
+/// Animations evaluate bezier segments through their 'csmAnimationBezierPolynomial's instead;
+/// this function is kept for tools working on control points.
 float csmBezierAnimationSegmentEvaluationFunction(const csmAnimationPoint* points, const float time);
 
 /// Builtin stepped animation segment evaluation.
@@ -135,18 +152,80 @@ enum
 };
 
 
+/// Animation segment types.
+enum
+{
+  /// Linear segment (evaluated by 'csmLinearAnimationSegmentEvaluationFunction').
+  csmLinearAnimationSegment,
+
+  /// Bezier segment (evaluated through its 'csmAnimationBezierPolynomial').
+  csmBezierAnimationSegment,
+
+  /// Stepped segment (evaluated by 'csmSteppedAnimationSegmentEvaluationFunction').
+  csmSteppedAnimationSegment,
+
+  /// Inverse stepped segment (evaluated by 'csmInverseSteppedAnimationSegmentEvaluationFunction').
+  csmInverseSteppedAnimationSegment,
+
+
+  /// Number of segment types.
+  // (Make sure this value always is the last value of the enumeration).
+  csmAnimationSegmentTypeCount
+};
+
+
+/// Packing of animation segments.
+enum
+{
+  /// Bit position of segment type.
+  csmAnimationSegmentTypeShift = 30,
+
+  /// Mask of index of first segment point.
+  csmAnimationSegmentBasePointIndexMask = 0x3FFFFFFF
+};
+
+
 /// Single animation curve segment.
+///
+/// Type and index of first point share 32 bits, as 2 bits suffice for the type.
 typedef struct csmAnimationSegment
 {
-  /// Allows evaluating segment.
-  csmAnimationSegmentEvaluationFunction Evaluate;
-
-  /// Index of first segment point.
-  int BasePointIndex;
+  /// Segment type (upper bits) and index of first segment point (lower bits).
+  unsigned int TypeAndBasePointIndex;
 }
 csmAnimationSegment;
 
 
+/// Bezier segment in polynomial form.
+///
+/// Polynomials are computed from control points at load time,
+/// so evaluating a segment takes a multiplication for normalizing time and a single Horner evaluation.
+typedef struct csmAnimationBezierPolynomial
+{
+  /// Time of first point.
+  float StartTime;
+
+  /// Reciprocal of segment duration ('0' for empty segments).
+  float InverseDuration;
+
+  /// Coefficients of value over normalized time (highest order first).
+  float Coefficients[4];
+}
+csmAnimationBezierPolynomial;
+
+
+/// Timing of an unrestricted bezier segment in polynomial form.
+///
+/// Unrestricted béziers can move their handles in time, so time isn't linear in the curve parameter.
+/// Evaluating them solves this polynomial for the curve parameter before evaluating the value polynomial.
+typedef struct csmAnimationBezierTimePolynomial
+{
+  /// Coefficients of normalized time over curve parameter (highest order first, constant term is always '0').
+  float Coefficients[3];
+}
+csmAnimationBezierTimePolynomial;
+
+
 /// Animation curve.
 typedef struct csmAnimationCurve
 {
@@ -156,21 +235,40 @@ typedef struct csmAnimationCurve
   /// ID of curve.
   csmHash Id;
 
-  /// Number of segments the curve contains.
+  /// Number of segments the curve contains ('-1' if curve isn't decoded yet).
   int SegmentCount;
 
   /// Index of first segment in curve.
   int BaseSegmentIndex;
+
+  /// Index of bezier polynomial of first bezier segment in curve (i.e. number of bezier segments preceding curve).
+  ///
+  /// Points of curves are laid out like in motion JSONs, i.e. consecutive segments share a point,
+  /// so the polynomial of any bezier segment of the curve can be located without counting.
+  int BaseBezierIndex;
+
+
+  /// Time from which on curve keeps its static value ('-FLT_MAX' for constant curves, 'FLT_MAX' if curve never settles).
+  float StaticTime;
+
+  /// Value of curve from static time on.
+  float StaticValue;
 }
 csmAnimationCurve;
 
 
 /// Animation.
+///
+/// Data is referenced by offsets relative to the animation instead of pointers,
+/// so animations can be moved in memory and serialized as is.
 typedef struct csmAnimation
 {
   /// Duration in seconds.
   float Duration;
 
+  /// Frames per second motion was authored at ('0' if unknown).
+  float Fps;
+
   /// Non-zero if animation should loop.
   short Loop;
 
@@ -178,18 +276,552 @@ typedef struct csmAnimation
   /// Number of curves.
   short CurveCount;
 
-  /// Curves.
-  csmAnimationCurve* Curves;
+  /// Total number of segments.
+  int TotalSegmentCount;
+
+  /// Total number of points.
+  int TotalPointCount;
+
+  /// Total number of bezier segments.
+  int TotalBezierCount;
+
+
+  /// Offset of curves (in bytes).
+  int CurvesOffset;
+
+  /// Offset of curve segments (in bytes).
+  int SegmentsOffset;
 
-  /// Curve segments.
-  csmAnimationSegment* Segments;
+  /// Offset of curve points (in bytes).
+  int PointsOffset;
 
-  /// Curve points.
-  csmAnimationPoint* Points;
+  /// Offset of bezier polynomials (in bytes).
+  ///
+  /// There's one polynomial per bezier segment (in order of segments),
+  /// so the index of a polynomial is the number of bezier segments preceding its segment.
+  int BezierPolynomialsOffset;
+
+  /// Offset of bezier time polynomials (in bytes; indexed like bezier polynomials).
+  ///
+  /// '0' if all béziers are restricted, i.e. their time is linear in the curve parameter.
+  int BezierTimePolynomialsOffset;
+
+  /// Offset of lazy source (in bytes; '0' if all curves are decoded).
+  int LazySourceOffset;
 }
 csmAnimation;
 
 
+/// Source of an animation whose curves are decoded on demand.
+///
+/// The source is followed by the offsets of the segments arrays of all curves into the serialized motion.
+typedef struct csmAnimationLazySource
+{
+  /// Serialized motion.
+  const char* MotionJson;
+
+  /// Length of serialized motion (in chars).
+  int Length;
+
+  /// Version of serialized motion.
+  int Version;
+
+  /// Index of segment to place next decoded curve at.
+  int NextSegmentIndex;
+
+  /// Index of point to place next decoded curve at.
+  int NextPointIndex;
+
+  /// Index of bezier polynomial to place next decoded curve at.
+  int NextBezierIndex;
+
+  /// Number of curves not decoded yet.
+  int UndecodedCurveCount;
+}
+csmAnimationLazySource;
+
+
+/// Header of a serialized animation blob.
+///
+/// The header is followed by the animation and its data.
+typedef struct csmAnimationBlobHeader
+{
+  /// Magic bytes ('CANM').
+  char Magic[4];
+
+  /// Format version.
+  unsigned int Version;
+
+  /// Byte order mark ('0x01020304' in byte order of writer).
+  unsigned int ByteOrderMark;
+
+  /// Total size of blob including header (in bytes).
+  unsigned int Size;
+}
+csmAnimationBlobHeader;
+
+
+/// Curve bound to a model.
+typedef struct csmAnimationCurveBinding
+{
+  /// Index of curve in animation.
+  int CurveIndex;
+
+  /// Index of parameter or part targeted by curve (or model curve type for model curves).
+  int TargetIndex;
+}
+csmAnimationCurveBinding;
+
+
+/// Animation bound to a model.
+///
+/// Curves targeting neither the model nor any existing parameter or part are dropped.
+typedef struct csmAnimationBinding
+{
+  /// Number of model curves.
+  int ModelCurveCount;
+
+  /// Number of bound parameter curves.
+  int ParameterCurveCount;
+
+  /// Number of bound part opacity curves.
+  int PartOpacityCurveCount;
+
+
+  /// Bound curves (model curves first, followed by parameter and part opacity curves each sorted by target index).
+  csmAnimationCurveBinding* Curves;
+}
+csmAnimationBinding;
+
+
+/// Set of parameters and parts of a model to restrict bindings to.
+typedef struct csmAnimationMask
+{
+  /// Number of parameters of model.
+  int ParameterCount;
+
+  /// Number of parts of model.
+  int PartCount;
+
+  /// Bit per parameter (set if parameter is in mask).
+  unsigned long long* ParameterBits;
+
+  /// Bit per part (set if part is in mask).
+  unsigned long long* PartBits;
+}
+csmAnimationMask;
+
+
+/// Per-curve segment cache of a playing animation.
+///
+/// Cursors only speed up segment look-ups, so evaluation stays correct for any cursor content.
+typedef struct csmAnimationCursor
+{
+  /// Number of curves.
+  int CurveCount;
+
+  /// Index of last evaluated segment per curve (relative to first segment of curve).
+  int* SegmentIndices;
+}
+csmAnimationCursor;
+
+
+/// Mixer for blending several animations into a model at once.
+///
+/// Accumulators hold parameters first, followed by parts.
+typedef struct csmAnimationMixer
+{
+  /// Number of parameters of model.
+  int ParameterCount;
+
+  /// Number of parts of model.
+  int PartCount;
+
+
+  /// Weighted sums of override values.
+  float* OverrideValues;
+
+  /// Sums of override weights.
+  float* OverrideWeights;
+
+  /// Weighted sums of lerp values.
+  float* LerpValues;
+
+  /// Sums of lerp weights.
+  float* LerpWeights;
+
+  /// Products of multiplicative factors.
+  float* MultiplicativeFactors;
+
+  /// Weighted sums of additive values.
+  float* AdditiveValues;
+}
+csmAnimationMixer;
+
+
+/// Evaluated curve values of an animation at a playhead.
+typedef struct csmAnimationEvaluationCacheEntry
+{
+  /// Cached animation ('0' if entry is unused).
+  const csmAnimation* Animation;
+
+  /// Quantized time values were evaluated at.
+  float Time;
+
+  /// Values indexed by curve.
+  float* Values;
+}
+csmAnimationEvaluationCacheEntry;
+
+/// Cache of evaluated animation curves shared by instances.
+typedef struct csmAnimationEvaluationCache
+{
+  /// Maximum number of curves per entry.
+  int CurveCount;
+
+  /// Number of entries.
+  int EntryCount;
+
+  /// Resolution times are quantized to.
+  float TimeResolution;
+
+  /// Index of entry to replace next.
+  int NextEntryIndex;
+
+
+  /// Entries.
+  csmAnimationEvaluationCacheEntry* Entries;
+}
+csmAnimationEvaluationCache;
+
+
+/// Animation resident in an animation library.
+typedef struct csmAnimationLibraryEntry
+{
+  /// Key animation was loaded with.
+  int Key;
+
+  /// Offset of animation into arena (in bytes).
+  unsigned int Offset;
+
+  /// Size of animation in arena (in bytes; '0' if entry is unused).
+  unsigned int Size;
+
+  /// Index of entry following in arena ('-1' if last).
+  int NextEntryIndex;
+
+  /// Library clock at last lookup of animation.
+  unsigned long long LastUse;
+}
+csmAnimationLibraryEntry;
+
+/// Memory-budgeted set of deserialized animations.
+typedef struct csmAnimationLibrary
+{
+  /// Maximum number of resident animations.
+  int EntryCount;
+
+  /// Index of entry placed first in arena ('-1' if library is empty).
+  int FirstEntryIndex;
+
+  /// Size of arena (in bytes).
+  unsigned int ArenaSize;
+
+  /// Number of arena bytes taken by resident animations.
+  unsigned int UsedSize;
+
+  /// Number of lookups that found their animation.
+  unsigned int HitCount;
+
+  /// Number of lookups that didn't find their animation.
+  unsigned int MissCount;
+
+  /// Number of animations evicted to make room.
+  unsigned int EvictionCount;
+
+  /// Clock advanced on each lookup.
+  unsigned long long Clock;
+
+  /// Entries.
+  csmAnimationLibraryEntry* Entries;
+
+  /// Arena animations are deserialized into.
+  char* Arena;
+
+  /// [Optional] Cache to drop evicted animations from.
+  csmAnimationEvaluationCache* EvaluationCache;
+}
+csmAnimationLibrary;
+
+
+/// Curve stored once in an animation curve pool.
+typedef struct csmAnimationPooledCurve
+{
+  /// Hash of curve content.
+  unsigned int Hash;
+
+  /// Number of segments.
+  int SegmentCount;
+
+  /// Index of first segment in pool storage.
+  int BaseSegmentIndex;
+
+  /// Index of first point in pool storage.
+  int BasePointIndex;
+
+  /// Number of points.
+  int PointCount;
+
+  /// Index of first bezier polynomial in pool storage.
+  int BaseBezierIndex;
+}
+csmAnimationPooledCurve;
+
+/// Pool of curves shared by animations.
+///
+/// Pooled animations are regular animations whose offsets reference the segments, points, and polynomials of the pool storage,
+/// so they evaluate like any other animation.
+typedef struct csmAnimationCurvePool
+{
+  /// Animation holding segments, points, and polynomials of unique curves (without curves of its own).
+  csmAnimation Storage;
+
+  /// Maximum number of pooled animations.
+  int AnimationCapacity;
+
+  /// Number of pooled animations.
+  int AnimationCount;
+
+  /// Maximum number of curves of all pooled animations.
+  int CurveCapacity;
+
+  /// Number of curves of all pooled animations.
+  int CurveCount;
+
+  /// Number of unique curves.
+  int UniqueCurveCount;
+
+  /// Maximum number of segments of unique curves.
+  int SegmentCapacity;
+
+  /// Maximum number of points of unique curves.
+  int PointCapacity;
+
+  /// Maximum number of bezier segments of unique curves.
+  int BezierCapacity;
+
+  /// Number of hash slots (power of 2).
+  int HashSlotCount;
+
+  /// Number of bytes taken by pooled animations.
+  unsigned int AnimationsSize;
+
+  /// Number of bytes pooled animations took before pooling.
+  unsigned int SourceSize;
+
+  /// Unique curves.
+  csmAnimationPooledCurve* UniqueCurves;
+
+  /// Hash slots holding indices of unique curves ('-1' if slot is empty).
+  int* HashSlots;
+
+  /// Memory pooled animations are placed in.
+  char* Animations;
+}
+csmAnimationCurvePool;
+
+
+/// Struct-of-arrays view of an animation for evaluating many curves at once.
+///
+/// Segments are grouped by type, and their control points are stored as the differences (or polynomials) the animation evaluation uses,
+/// so that evaluating a view performs exactly the same float operations as evaluating the animation itself.
+typedef struct csmAnimationView
+{
+  /// Index of each segment of animation into the arrays of its segment group.
+  int* SegmentSlots;
+
+  /// Number of segments of animation.
+  int SegmentCount;
+
+
+  /// Linear segments.
+  struct
+  {
+    /// Times of first points.
+    float* StartTimes;
+
+    /// Time differences between last and first points.
+    float* Durations;
+
+    /// Values of first points.
+    float* StartValues;
+
+    /// Value differences between last and first points.
+    float* ValueDeltas;
+
+    /// Number of segments.
+    int Count;
+  }
+  LinearSegments;
+
+  /// Bezier segments.
+  struct
+  {
+    /// Times of first points.
+    float* StartTimes;
+
+    /// Reciprocals of segment durations.
+    float* InverseDurations;
+
+    /// Polynomial coefficients (highest order first).
+    float* Coefficients[4];
+
+    /// [Optional] Time polynomial coefficients (highest order first; '0' if béziers are restricted).
+    float* TimeCoefficients[3];
+
+    /// Number of segments.
+    int Count;
+  }
+  BezierSegments;
+
+  /// Stepped and inverse stepped segments.
+  struct
+  {
+    /// Constant values.
+    float* Values;
+
+    /// Number of segments.
+    int Count;
+  }
+  ConstantSegments;
+}
+csmAnimationView;
+
+
+/// Value range of a quantized baked curve.
+typedef struct csmBakedAnimationCurveRange
+{
+  /// Value of quantized '0'.
+  float Minimum;
+
+  /// Value difference per quantization step.
+  float Scale;
+}
+csmBakedAnimationCurveRange;
+
+
+/// Animation resampled at a fixed rate.
+///
+/// Like animations, data is referenced by offsets relative to the baked animation.
+typedef struct csmBakedAnimation
+{
+  /// Duration in seconds.
+  float Duration;
+
+  /// Samples per second (rounded up from the requested rate so that samples span duration evenly).
+  float SampleRate;
+
+  /// Non-zero if animation should loop.
+  short Loop;
+
+  /// Number of curves.
+  short CurveCount;
+
+  /// Number of samples per curve.
+  int SampleCount;
+
+
+  /// Offset of value ranges of curves (in bytes; '0' if samples aren't quantized).
+  int RangesOffset;
+
+  /// Offset of samples (in bytes).
+  ///
+  /// Samples are stored curve by curve, either as 'float's or, if quantized, as 'unsigned short's.
+  int SamplesOffset;
+}
+csmBakedAnimation;
+
+
+/// Key of a compressed animation curve.
+///
+/// Curves are linearly interpolated between keys. Steps are stored as two keys at the same time.
+typedef struct csmCompressedAnimationKey
+{
+  /// Quantized time (in steps of 'csmCompressedAnimation.TimeScale').
+  unsigned short Time;
+
+  /// Quantized value (in steps of 'csmCompressedAnimationCurve.ValueScale').
+  unsigned short Value;
+}
+csmCompressedAnimationKey;
+
+
+/// Curve of a compressed animation.
+typedef struct csmCompressedAnimationCurve
+{
+  /// Index of first key.
+  int BaseKeyIndex;
+
+  /// Number of keys (always at least '1'; '1' for constant curves).
+  int KeyCount;
+
+  /// Value of quantized '0'.
+  float MinimumValue;
+
+  /// Value difference per quantization step.
+  float ValueScale;
+
+  /// Maximum difference to source curve measured while compressing.
+  float MaxError;
+}
+csmCompressedAnimationCurve;
+
+
+/// Lossy compressed animation.
+///
+/// Like animations, data is referenced by offsets relative to the compressed animation.
+typedef struct csmCompressedAnimation
+{
+  /// Duration in seconds.
+  float Duration;
+
+  /// Seconds per quantized time step.
+  float TimeScale;
+
+  /// Non-zero if animation should loop.
+  short Loop;
+
+  /// Number of curves.
+  short CurveCount;
+
+  /// Total number of keys.
+  int TotalKeyCount;
+
+  /// Size of source animation (in bytes).
+  unsigned int SourceSize;
+
+
+  /// Offset of curves (in bytes).
+  int CurvesOffset;
+
+  /// Offset of keys (in bytes).
+  int KeysOffset;
+}
+csmCompressedAnimation;
+
+
+/// Key cache of a playing compressed animation.
+typedef struct csmCompressedAnimationCursor
+{
+  /// Number of curves.
+  int CurveCount;
+
+  /// Index of last evaluated key per curve (relative to first key of curve).
+  int* KeyIndices;
+}
+csmCompressedAnimationCursor;
+
+
 // ------- //
 // PHYSICS //
 // ------- //
@@ -208,6 +840,11 @@ enum
   csmSourceYPhysics,
 
   csmSourceAnglePhysics,
+
+
+  /// Number of source types.
+  // (Make sure this value always is the last value of the enumeration).
+  csmPhysicsSourceTypeCount
 };
 
 // TODO Document
@@ -368,6 +1005,112 @@ typedef struct csmPhysicsRig
 csmPhysicsRig;
 
 
+/// Header of a serialized physics rig blob.
+///
+/// The header is followed by the sub rigs, inputs, outputs, and particles of the rig in that order.
+typedef struct csmPhysicsBlobHeader
+{
+  /// Magic bytes ('CPHY').
+  char Magic[4];
+
+  /// Format version.
+  unsigned int Version;
+
+  /// Byte order mark ('0x01020304' in byte order of writer).
+  unsigned int ByteOrderMark;
+
+  /// Total size of blob including header (in bytes).
+  unsigned int Size;
+
+
+  /// Number of sub rigs.
+  int SubRigCount;
+
+  /// Total number of inputs.
+  int TotalInputCount;
+
+  /// Total number of outputs.
+  int TotalOutputCount;
+
+  /// Total number of particles.
+  int ParticleCount;
+
+
+  /// Gravity.
+  csmVector2 Gravity;
+
+  /// Wind.
+  csmVector2 Wind;
+}
+csmPhysicsBlobHeader;
+
+
+/// Serialized physics input.
+typedef struct csmSerializedPhysicsInput
+{
+  /// Source parameter.
+  csmPhysicsParameter Source;
+
+  /// Input weight.
+  float Weight;
+
+  /// Source type.
+  short Type;
+
+  /// Non-zero if input is inverted.
+  short Reflect;
+}
+csmSerializedPhysicsInput;
+
+
+/// Serialized physics output.
+typedef struct csmSerializedPhysicsOutput
+{
+  /// Destination parameter.
+  csmPhysicsParameter Destination;
+
+  /// Index of particle to output.
+  int VertexIndex;
+
+  /// Translation scale.
+  csmVector2 TranslationScale;
+
+  /// Angle scale.
+  float AngleScale;
+
+  /// Output weight.
+  float Weight;
+
+  /// Source type.
+  short Type;
+
+  /// Non-zero if output is inverted.
+  short Reflect;
+}
+csmSerializedPhysicsOutput;
+
+
+/// Serialized physics particle.
+typedef struct csmSerializedPhysicsParticle
+{
+  /// Rest position.
+  csmVector2 InitialPosition;
+
+  /// Mobility.
+  float Mobility;
+
+  /// Delay.
+  float Delay;
+
+  /// Acceleration.
+  float Acceleration;
+
+  /// Radius.
+  float Radius;
+}
+csmSerializedPhysicsParticle;
+
+
 // ---------------- //
 // MODEL EXTENSIONS //
 // ---------------- //
@@ -393,6 +1136,48 @@ csmHash csmHashIdFromSubString(const char* string, const int idBegin, const int
 /// @param  userData    [Optional] Data to pass to token handler.
 void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userData);
 
+/// Lexes a JSON string of known length.
+///
+/// The string doesn't have to be null-terminated and is never read past 'length'.
+///
+/// @param  jsonString  JSON string to lex.
+/// @param  length      Length of string (in chars).
+/// @param  onToken     Token handler.
+/// @param  userData    [Optional] Data to pass to token handler.
+void csmLexJsonWithLength(const char* jsonString, const unsigned int length, csmJsonTokenHandler onToken, void* userData);
+
+/// Lexes a JSON string into a token tape for replaying it later on.
+///
+/// @param  jsonString  JSON string to lex.
+/// @param  tape        [Optional] Tape to write tokens to.
+/// @param  capacity    Maximum number of tokens to write to tape.
+///
+/// @return  Number of tokens in string (which is bigger than 'capacity' if tape was too small).
+int csmLexJsonIntoTape(const char* jsonString, csmJsonToken* tape, const int capacity);
+
+/// Lexes a JSON string of known length into a token tape.
+///
+/// @param  jsonString  JSON string to lex (doesn't have to be null-terminated).
+/// @param  length      Length of string (in chars).
+/// @param  tape        [Optional] Tape to write tokens to.
+/// @param  capacity    Maximum number of tokens to write to tape.
+///
+/// @return  Number of tokens in string (which is bigger than 'capacity' if tape was too small).
+int csmLexJsonIntoTapeWithLength(const char* jsonString, const unsigned int length, csmJsonToken* tape, const int capacity);
+
+/// Replays a token tape as if lexing a JSON string.
+///
+/// @param  jsonString  JSON string tape was lexed from.
+/// @param  tape        Tape to replay.
+/// @param  tokenCount  Number of tokens in tape.
+/// @param  onToken     Token handler.
+/// @param  userData    [Optional] Data to pass to token handler.
+void csmReplayJsonTape(const char* jsonString,
+                       const csmJsonToken* tape,
+                       const int tokenCount,
+                       csmJsonTokenHandler onToken,
+                       void* userData);
+
 
 // --------- //
 // ANIMATION //
@@ -400,16 +1185,27 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
 
 /// Initializes an animation.
 ///
+/// Data is stored relative to the animation, so make sure it's close to the animation in memory (e.g. in the same block).
+/// Points of curves have to be laid out like in motion JSONs (i.e. consecutive segments of a curve share a point).
+///
 /// @param  animation     Animation to reset.
 /// @param  duration      Duration in seconds.
+/// @param  fps           Frames per second ('0' if unknown).
 /// @param  loop          Loop flag.
 /// @param  curves        Curve data.
 /// @param  curveCount    Number of curves.
 /// @param  segments      Segment data.
+/// @param  segmentCount  Number of segments.
 /// @param  points        Point data.
-void csmInitializesAnimation(csmAnimation* animation,
-                             float duration,
-                             short loop,
-                             csmAnimationCurve* curves, const short curveCount,
-                             csmAnimationSegment* segments,
-                             csmAnimationPoint* points);
+/// @param  pointCount    Number of points.
+/// @param  polynomials      Memory for bezier polynomials (one per bezier segment, computed from segments and points).
+/// @param  timePolynomials  [Optional] Memory for bezier time polynomials (one per bezier segment) if béziers are unrestricted.
+void csmInitializeAnimation(csmAnimation* animation,
+                            float duration,
+                            float fps,
+                            short loop,
+                            csmAnimationCurve* curves, const short curveCount,
+                            csmAnimationSegment* segments, const int segmentCount,
+                            csmAnimationPoint* points, const int pointCount,
+                            csmAnimationBezierPolynomial* polynomials,
+                            csmAnimationBezierTimePolynomial* timePolynomials);
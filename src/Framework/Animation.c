@@ -18,115 +18,978 @@
 
 #include <Live2DCubismCore.h>
 
+#include <float.h>
+#include <limits.h>
+#include <string.h>
+
 
 // ------- //
 // HELPERS //
 // ------- //
 
-/// Evaluates curve.
-///
-/// @param  animation  Animation containing curve.
-/// @param  index      Curve index.
-/// @param  time       Time to evaluate at.
-///
-/// @return  Value at time.
-static float EvaluateCurve(const csmAnimation* animation, const int index, float time)
-{
-  csmAnimationSegment* segment, * lastSegment;
-  csmAnimationPoint* nextBasePoint;
-  csmAnimationCurve* curve;
+/// Magic bytes of serialized animations.
+static const char BlobMagic[4] = { 'C', 'A', 'N', 'M' };
+
+/// Version of serialized animations.
+static const unsigned int BlobVersion = 8;
+
+/// Byte order mark of serialized animations.
+static const unsigned int BlobByteOrderMark = 0x01020304;
+
+
+/// Maximum number of iterations for solving bezier time polynomials.
+static const int MaxBezierSolverIterations = 24;
+
+/// Tolerance for solving bezier time polynomials (in normalized time).
+static const float BezierSolverTolerance = 1.0e-6f;
+
+/// Tolerance for treating bezier handles as restricted (in normalized time).
+static const float RestrictedBezierHandleTolerance = 1.0e-5f;
+
+
+/// Checks whether an array of a serialized animation lies within its blob.
+///
+/// @param  offset       Offset of array relative to animation (in bytes).
+/// @param  count        Number of elements in array.
+/// @param  elementSize  Size of a single element (in bytes).
+/// @param  dataSize     Size of animation including its data (in bytes).
+///
+/// @return  Non-zero if array lies within blob; '0' otherwise.
+static int IsArrayInBlob(const int offset, const int count, const unsigned int elementSize, const unsigned int dataSize)
+{
+  return offset >= (int)sizeof(csmAnimation)
+    && count >= 0
+    && ((unsigned long long)offset + ((unsigned long long)count * elementSize)) <= dataSize;
+}
+
+
+/// Clamps a value to '[0, 1]'.
+///
+/// @param  value  Value to clamp.
+///
+/// @return  Clamped value.
+static float Saturate(const float value)
+{
+  return (value < 0.0f)
+    ? 0.0f
+    : (value > 1.0f)
+      ? 1.0f
+      : value;
+}
+
+/// Checks whether two values are close.
+///
+/// @param  a          First value.
+/// @param  b          Second value.
+/// @param  tolerance  Maximum difference.
+///
+/// @return  Non-zero if values are close; '0' otherwise.
+static int IsClose(const float a, const float b, const float tolerance)
+{
+  return (a - b) <= tolerance && (b - a) <= tolerance;
+}
+
+
+/// Gets the value of a segment that holds a single value.
+///
+/// @param  animation  Animation containing segment.
+/// @param  index      Segment index.
+/// @param  value      Value of segment.
+///
+/// @return  Non-zero if segment holds a single value; '0' otherwise.
+static int GetStaticSegmentValue(const csmAnimation* animation, const int index, float* value)
+{
+  const csmAnimationSegment* segment;
+  const csmAnimationPoint* points;
+  int basePointIndex;
+
+
+  segment = GetAnimationSegments(animation) + index;
+  basePointIndex = GetAnimationSegmentBasePointIndex(segment);
+
+
+  // Ignore segments referencing points out of range.
+  if (basePointIndex > (animation->TotalPointCount - ((GetAnimationSegmentType(segment) == csmBezierAnimationSegment)
+    ? 4
+    : 2)))
+  {
+    return 0;
+  }
+
+
+  points = GetAnimationPoints(animation) + basePointIndex;
+
+
+  switch (GetAnimationSegmentType(segment))
+  {
+    case csmLinearAnimationSegment:
+    {
+      *value = points[0].Value;
+
+
+      return points[1].Value == points[0].Value;
+    }
+    case csmBezierAnimationSegment:
+    {
+      *value = points[0].Value;
+
+
+      return points[1].Value == points[0].Value
+        && points[2].Value == points[0].Value
+        && points[3].Value == points[0].Value;
+    }
+    case csmSteppedAnimationSegment:
+    {
+      *value = points[0].Value;
+
+
+      return 1;
+    }
+    default:
+    {
+      *value = points[1].Value;
+
+
+      return 1;
+    }
+  }
+}
+
+
+/// Inserts a curve binding keeping bindings sorted by target index.
+///
+/// Insertion is stable, so curves targeting the same value are still applied in order.
+///
+/// @param  bindings     Sorted bindings (with room for one more binding).
+/// @param  count        Number of bindings.
+/// @param  curveIndex   Index of curve to bind.
+/// @param  targetIndex  Index of value curve targets.
+static void InsertCurveBinding(csmAnimationCurveBinding* bindings, const int count, const int curveIndex, const int targetIndex)
+{
+  int b;
+
+
+  for (b = count; b > 0 && bindings[b - 1].TargetIndex > targetIndex; --b)
+  {
+    bindings[b] = bindings[b - 1];
+  }
+
+
+  bindings[b].CurveIndex = curveIndex;
+  bindings[b].TargetIndex = targetIndex;
+}
+
+
+/// Computes the deserialized size of an animation.
+///
+/// @param  meta  Meta of serialized animation.
+///
+/// @return  Number of bytes necessary.
+static unsigned int GetDeserializedSizeofAnimation(const MotionJsonMeta* meta)
+{
+  return (unsigned int)(sizeof(csmAnimation)
+    + (sizeof(csmAnimationCurve) * meta->CurveCount)
+    + (sizeof(csmAnimationSegment) * meta->TotalSegmentCount)
+    + (sizeof(csmAnimationPoint) * meta->TotalPointCount)
+    + (sizeof(csmAnimationBezierPolynomial) * meta->TotalBezierCount)
+    + ((meta->AreBeziersRestricted)
+      ? 0
+      : (sizeof(csmAnimationBezierTimePolynomial) * meta->TotalBezierCount)));
+}
+
+/// Computes the size of a lazily deserialized animation.
+///
+/// @param  meta  Meta of serialized animation.
+///
+/// @return  Number of bytes necessary.
+static unsigned int GetLazyDeserializedSizeofAnimation(const MotionJsonMeta* meta)
+{
+  return (unsigned int)(AlignLazySourceOffset((int)GetDeserializedSizeofAnimation(meta))
+    + sizeof(csmAnimationLazySource)
+    + (sizeof(int) * meta->CurveCount));
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+float EvaluateAnimationCurve(const csmAnimation* animation, const int index, float time, int* segmentIndex)
+{
+  const csmAnimationBezierTimePolynomial* timePolynomials;
+  const csmAnimationBezierPolynomial* polynomial;
+  const csmAnimationSegment* segment;
+  const csmAnimationPoint* points;
+  const csmAnimationCurve* curve;
+  int s, b;
+
+
+  DecodeAnimationCurveOnDemand(animation, index);
+
+
+  curve = GetAnimationCurves(animation) + index;
+
+
+  // Skip searching segments of curves that settled (NaNs take the regular path).
+  if (time >= curve->StaticTime)
+  {
+    return curve->StaticValue;
+  }
+
+
+  points = GetAnimationPoints(animation);
+
+
+  // Find segment to evaluate.
+  segment = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  s = FindAnimationSegment(segment, curve->SegmentCount, points, time, (segmentIndex)
+    ? *segmentIndex
+    : 0);
+
+
+  if (segmentIndex)
+  {
+    *segmentIndex = s;
+  }
+
+
+  segment += s;
+  points += GetAnimationSegmentBasePointIndex(segment);
+
+
+  // Dispatch on segment type (so that evaluation can be inlined).
+  switch (GetAnimationSegmentType(segment))
+  {
+    case csmLinearAnimationSegment:
+    {
+      return EvaluateLinearAnimationSegment(points, time);
+    }
+    case csmBezierAnimationSegment:
+    {
+      // Evaluate bezier segments through their polynomials.
+      b = GetAnimationBezierIndex(animation, curve, curve->BaseSegmentIndex + s);
+      polynomial = GetAnimationBezierPolynomials(animation) + b;
+      timePolynomials = GetAnimationBezierTimePolynomials(animation);
+
+
+      return (timePolynomials)
+        ? EvaluateUnrestrictedBezierPolynomial(polynomial, timePolynomials + b, time)
+        : EvaluateBezierPolynomial(polynomial, time);
+    }
+    case csmSteppedAnimationSegment:
+    {
+      return points[0].Value;
+    }
+    default:
+    {
+      return points[1].Value;
+    }
+  }
+}
+
+
+void InitializeAnimationBezierPolynomials(csmAnimation* animation)
+{
+  // Take restricted path if possible.
+  if (InitializeAnimationBezierPolynomialRange(animation, 0, animation->TotalSegmentCount, 0))
+  {
+    animation->BezierTimePolynomialsOffset = 0;
+  }
+}
+
+int InitializeAnimationBezierPolynomialRange(csmAnimation* animation,
+                                             const int firstSegment,
+                                             const int segmentCount,
+                                             const int firstBezier)
+{
+  csmAnimationBezierTimePolynomial* timePolynomials;
+  csmAnimationBezierPolynomial* polynomials;
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  float duration, handle1, handle2;
+  int s, b, areBeziersRestricted;
+
+
+  polynomials = GetAnimationBezierPolynomials(animation);
+  timePolynomials = GetAnimationBezierTimePolynomials(animation);
+  segments = GetAnimationSegments(animation);
+
+
+  areBeziersRestricted = 1;
+  b = firstBezier - 1;
+
+
+  for (s = firstSegment; s < (firstSegment + segmentCount); ++s)
+  {
+    // Skip other segments...
+    if (GetAnimationSegmentType(segments + s) != csmBezierAnimationSegment)
+    {
+      continue;
+    }
+
+
+    ++b;
+
+
+    // ... and béziers referencing points or polynomials out of range (keeping polynomials of later béziers in place).
+    if (GetAnimationSegmentBasePointIndex(segments + s) > (animation->TotalPointCount - 4)
+      || b >= animation->TotalBezierCount)
+    {
+      continue;
+    }
+
+
+    points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(segments + s);
+    duration = points[3].Time - points[0].Time;
+
+
+    polynomials[b].StartTime = points[0].Time;
+    polynomials[b].InverseDuration = (duration > 0.0f)
+      ? (1.0f / duration)
+      : 0.0f;
+
+
+    // Expand Bernstein form into power form.
+    polynomials[b].Coefficients[0] = (points[3].Value - points[0].Value) + (3.0f * (points[1].Value - points[2].Value));
+    polynomials[b].Coefficients[1] = 3.0f * ((points[2].Value - points[1].Value) - (points[1].Value - points[0].Value));
+    polynomials[b].Coefficients[2] = 3.0f * (points[1].Value - points[0].Value);
+    polynomials[b].Coefficients[3] = points[0].Value;
+
+
+    if (!timePolynomials)
+    {
+      continue;
+    }
+
+
+    // Do the same for time (keeping handles within segment so that time never decreases).
+    handle1 = Saturate((points[1].Time - points[0].Time) * polynomials[b].InverseDuration);
+    handle2 = Saturate((points[2].Time - points[0].Time) * polynomials[b].InverseDuration);
+
+
+    timePolynomials[b].Coefficients[0] = 1.0f + (3.0f * (handle1 - handle2));
+    timePolynomials[b].Coefficients[1] = 3.0f * ((handle2 - handle1) - handle1);
+    timePolynomials[b].Coefficients[2] = 3.0f * handle1;
+
+
+    areBeziersRestricted = areBeziersRestricted
+      && IsClose(handle1, 1.0f / 3.0f, RestrictedBezierHandleTolerance)
+      && IsClose(handle2, 2.0f / 3.0f, RestrictedBezierHandleTolerance);
+  }
+
+
+  return areBeziersRestricted;
+}
+
+void InitializeAnimationStaticCurves(csmAnimation* animation)
+{
+  int c;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    InitializeAnimationStaticCurve(animation, c);
+  }
+}
+
+void InitializeAnimationStaticCurve(csmAnimation* animation, const int index)
+{
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  csmAnimationCurve* curve;
+  float staticValue, value;
+  int s;
+
+
+  segments = GetAnimationSegments(animation);
+  points = GetAnimationPoints(animation);
+
+
+  curve = GetAnimationCurves(animation) + index;
+  curve->StaticTime = FLT_MAX;
+  curve->StaticValue = 0.0f;
+
+
+  // Skip curves whose last segment changes (and curves referencing segments out of range).
+  s = curve->BaseSegmentIndex + curve->SegmentCount - 1;
+
+
+  if (curve->SegmentCount < 1
+    || curve->BaseSegmentIndex < 0
+    || s >= animation->TotalSegmentCount
+    || !GetStaticSegmentValue(animation, s, &staticValue))
+  {
+    return;
+  }
+
+
+  // Walk back over segments holding the same value.
+  for (; s > curve->BaseSegmentIndex; --s)
+  {
+    if (!GetStaticSegmentValue(animation, s - 1, &value) || value != staticValue)
+    {
+      break;
+    }
+  }
+
+
+  // Curves that hold the value from their first segment on are constant (before their first point, too).
+  curve->StaticTime = (s == curve->BaseSegmentIndex)
+    ? -FLT_MAX
+    : points[GetAnimationSegmentBasePointIndex(segments + s)].Time;
+  curve->StaticValue = staticValue;
+}
+
+int GetAnimationCurvePointRange(const csmAnimation* animation, const csmAnimationCurve* curve, int* basePointIndex, int* pointCount)
+{
+  const csmAnimationSegment* segments;
+  int s, end, segmentEnd;
+
+
+  if (curve->SegmentCount < 1
+    || curve->BaseSegmentIndex < 0
+    || curve->BaseSegmentIndex > (animation->TotalSegmentCount - curve->SegmentCount))
+  {
+    return 0;
+  }
+
+
+  segments = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  *basePointIndex = GetAnimationSegmentBasePointIndex(segments);
+  end = *basePointIndex;
+
+
+  // Find end of last segment (as segments share their first point with the previous segment).
+  for (s = 0; s < curve->SegmentCount; ++s)
+  {
+    segmentEnd = GetAnimationSegmentBasePointIndex(segments + s) + ((GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+      ? 4
+      : 2);
+
+
+    if (GetAnimationSegmentBasePointIndex(segments + s) < *basePointIndex)
+    {
+      return 0;
+    }
+
+
+    end = (segmentEnd > end)
+      ? segmentEnd
+      : end;
+  }
+
+
+  *pointCount = end - *basePointIndex;
+
+
+  return end <= animation->TotalPointCount;
+}
+
+
+void DecodeLazyAnimationCurve(csmAnimation* animation, const int index)
+{
+  csmAnimationLazySource* lazySource;
+  const csmAnimationCurve* curve;
+
+
+  lazySource = GetAnimationLazySource(animation);
+
+
+  // Decode curve and prepare it for evaluation like a deserialized one.
+  ReadLazyMotionJsonCurve(animation, index);
+
+
+  curve = GetAnimationCurves(animation) + index;
+
+
+  InitializeAnimationBezierPolynomialRange(animation, curve->BaseSegmentIndex, curve->SegmentCount, curve->BaseBezierIndex);
+  InitializeAnimationStaticCurve(animation, index);
+
+
+  // Drop source once all curves are decoded.
+  lazySource->UndecodedCurveCount -= 1;
+
+
+  if (lazySource->UndecodedCurveCount == 0)
+  {
+    animation->LazySourceOffset = 0;
+  }
+}
+
+
+float SolveBezierTimePolynomial(const float a, const float b, const float c, const float time)
+{
+  float t, lower, upper, error, slope;
+  int i;
+
+
+  // Clamp to segment (handling NaNs, too).
+  if (!(time > 0.0f))
+  {
+    return 0.0f;
+  }
+
+  if (time >= 1.0f)
+  {
+    return 1.0f;
+  }
+
+
+  // Refine guess with Newton's method, falling back to bisection whenever a step leaves the bracket of the solution.
+  lower = 0.0f;
+  upper = 1.0f;
+  t = time;
+
+
+  for (i = 0; i < MaxBezierSolverIterations; ++i)
+  {
+    error = (((((a * t) + b) * t) + c) * t) - time;
+
+
+    if (IsClose(error, 0.0f, BezierSolverTolerance))
+    {
+      break;
+    }
+
+
+    if (error < 0.0f)
+    {
+      lower = t;
+    }
+    else
+    {
+      upper = t;
+    }
+
+
+    slope = (((3.0f * a * t) + (2.0f * b)) * t) + c;
+    t -= error / slope;
+
+
+    if (!(t > lower && t < upper))
+    {
+      t = (lower + upper) * 0.5f;
+    }
+  }
+
+
+  return t;
+}
+
+
+unsigned int csmGetDeserializedSizeofAnimation(const char* motionJson)
+{
+  // Validate argument.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+
+
+  return csmGetDeserializedSizeofAnimationWithLength(motionJson, (unsigned int)strlen(motionJson));
+}
+
+unsigned int csmGetDeserializedSizeofAnimationWithLength(const char* motionJson, const unsigned int length)
+{
+  MotionJsonMeta meta;
+
+
+  // Validate arguments.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+
+
+  Ensure(ReadMotionJsonMeta(motionJson, (int)length, 0, 0, &meta), "\"motionJson\" is invalid.", return 0);
+
+
+  return GetDeserializedSizeofAnimation(&meta);
+}
+
+
+csmAnimation* csmDeserializeAnimationInPlace(const char *motionJson, void* address, const unsigned int size)
+{
+  // Validate argument.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+
+
+  return csmDeserializeAnimationInPlaceWithLength(motionJson, (unsigned int)strlen(motionJson), address, size);
+}
+
+csmAnimation* csmDeserializeAnimationInPlaceWithLength(const char* motionJson,
+                                                       const unsigned int length,
+                                                       void* address,
+                                                       const unsigned int size)
+{
+  csmAnimation* animation;
+  MotionJsonMeta meta;
+
+
+  // Validate arguments.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+
+
+  // 'Patch' pointer.
+  animation = (csmAnimation*)address;
+
+
+  // Deserialize animation.
+  Ensure(ReadMotionJsonMeta(motionJson, (int)length, 0, 0, &meta), "\"motionJson\" is invalid.", return 0);
+  Ensure((size >= GetDeserializedSizeofAnimation(&meta)), "\"size\" is invalid.", return 0);
+  Ensure(ReadMotionJson(motionJson, (int)length, 0, 0, &meta, animation), "\"motionJson\" is invalid.", return 0);
+
+
+  return animation;
+}
+
+
+csmAnimation* csmDeserializeAnimation(const char* motionJson,
+                                      csmAllocateFunction allocate,
+                                      csmDeallocateFunction deallocate)
+{
+  // Validate argument.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+
+
+  return csmDeserializeAnimationWithLength(motionJson, (unsigned int)strlen(motionJson), allocate, deallocate);
+}
+
+csmAnimation* csmDeserializeAnimationWithLength(const char* motionJson,
+                                                const unsigned int length,
+                                                csmAllocateFunction allocate,
+                                                csmDeallocateFunction deallocate)
+{
+  csmAnimation* animation;
+  csmJsonToken* tape;
+  MotionJsonMeta meta;
+  int tokenCount;
+
+
+  // Validate arguments.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+  Ensure(allocate, "\"allocate\" is invalid.", return 0);
+  Ensure(deallocate, "\"deallocate\" is invalid.", return 0);
+
+
+  // Lex once...
+  tape = LexJsonIntoAllocatedTape(motionJson, (int)length, allocate, deallocate, &tokenCount);
+
+
+  if (!tape)
+  {
+    return 0;
+  }
+
+
+  // ... and replay tape for sizing and reading.
+  if (!ReadMotionJsonMeta(motionJson, (int)length, tape, tokenCount, &meta))
+  {
+    Log("[Live2D Cubism Components] \"motionJson\" is invalid.");
+
+
+    deallocate(tape);
+
+
+    return 0;
+  }
+
+
+  animation = allocate(GetDeserializedSizeofAnimation(&meta));
+
+
+  if (!animation)
+  {
+    Log("[Live2D Cubism Components] Failed to allocate animation.");
+  }
+  else if (!ReadMotionJson(motionJson, (int)length, tape, tokenCount, &meta, animation))
+  {
+    Log("[Live2D Cubism Components] \"motionJson\" is invalid.");
+
+
+    deallocate(animation);
+
+
+    animation = 0;
+  }
+
+
+  deallocate(tape);
+
+
+  return animation;
+}
+
+unsigned int csmGetLazyDeserializedSizeofAnimationWithLength(const char* motionJson, const unsigned int length)
+{
+  MotionJsonMeta meta;
+
+
+  // Validate arguments.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+
+
+  Ensure(ReadMotionJsonMeta(motionJson, (int)length, 0, 0, &meta), "\"motionJson\" is invalid.", return 0);
+
+
+  return GetLazyDeserializedSizeofAnimation(&meta);
+}
+
+csmAnimation* csmDeserializeAnimationLazilyInPlaceWithLength(const char* motionJson,
+                                                             const unsigned int length,
+                                                             void* address,
+                                                             const unsigned int size)
+{
+  csmAnimation* animation;
+  unsigned int requiredSize;
+  MotionJsonMeta meta;
+
+
+  // Validate arguments.
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure(((size_t)address % sizeof(void*)) == 0, "\"address\" is misaligned.", return 0);
+
+
+  Ensure(ReadMotionJsonMeta(motionJson, (int)length, 0, 0, &meta), "\"motionJson\" is invalid.", return 0);
+
+
+  requiredSize = GetLazyDeserializedSizeofAnimation(&meta);
+
+
+  Ensure((size >= requiredSize), "\"size\" is invalid.", return 0);
+
+
+  // 'Patch' pointer.
+  animation = (csmAnimation*)address;
+
+
+  // Read curve headers only.
+  Ensure(ReadMotionJsonLazily(motionJson, (int)length, &meta, animation), "\"motionJson\" is invalid.", return 0);
+
+
+  return animation;
+}
+
+void csmDecodeAnimation(csmAnimation* animation)
+{
+  int c;
+
+
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return);
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    DecodeAnimationCurveOnDemand(animation, c);
+  }
+}
+
+int csmIsAnimationDecoded(const csmAnimation* animation)
+{
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+
+
+  return !animation->LazySourceOffset;
+}
+
+
+void csmInitializeAnimation(csmAnimation* animation,
+                            float duration,
+                            float fps,
+                            short loop,
+                            csmAnimationCurve* curves, const short curveCount,
+                            csmAnimationSegment* segments, const int segmentCount,
+                            csmAnimationPoint* points, const int pointCount,
+                            csmAnimationBezierPolynomial* polynomials,
+                            csmAnimationBezierTimePolynomial* timePolynomials)
+{
+  int c, s, bezierCount;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure((duration > 0.0f), "\"duration\" is invalid.", return);
+  Ensure(curves, "\"curves\" are invalid.", return);
+  Ensure((curveCount > 0), "\"curveCount\" is invalid.", return);
+  Ensure(segments, "\"segments\" is invalid.", return);
+  Ensure(points, "\"points\" is invalid.", return);
+  Ensure(polynomials, "\"polynomials\" are invalid.", return);
+
+
+  // Store   
+  animation->Duration = duration;
+  animation->Fps = fps;
+  animation->Loop = loop;
 
+  animation->CurveCount = curveCount;
+  animation->TotalSegmentCount = segmentCount;
+  animation->TotalPointCount = pointCount;
+  animation->TotalBezierCount = 0;
 
-  curve = animation->Curves + index;
+  animation->CurvesOffset = (int)((char*)curves - (char*)animation);
+  animation->SegmentsOffset = (int)((char*)segments - (char*)animation);
+  animation->PointsOffset = (int)((char*)points - (char*)animation);
+  animation->BezierPolynomialsOffset = (int)((char*)polynomials - (char*)animation);
+  animation->BezierTimePolynomialsOffset = (timePolynomials)
+    ? (int)((char*)timePolynomials - (char*)animation)
+    : 0;
+  animation->LazySourceOffset = 0;
 
 
-  // Find segment to evaluate.
-  segment = animation->Segments + curve->BaseSegmentIndex;
-  lastSegment = segment + curve->SegmentCount - 1;
+  // Locate bezier polynomials of curves (walking segments once as long as curves are in order).
+  s = 0;
+  bezierCount = 0;
 
 
-  for (; segment < lastSegment; ++segment)
+  for (c = 0; c < curveCount; ++c)
   {
-    // Get first point of next segment.
-    nextBasePoint = animation->Points + (segment + 1)->BasePointIndex;
+    if (curves[c].BaseSegmentIndex < s)
+    {
+      s = 0;
+      bezierCount = 0;
+    }
 
 
-    // Break if time lies within current segment.
-    if (nextBasePoint->Time > time)
+    for (; s < curves[c].BaseSegmentIndex && s < segmentCount; ++s)
     {
-      break;
+      bezierCount += (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment);
     }
+
+
+    curves[c].BaseBezierIndex = bezierCount;
+  }
+
+
+  for (s = 0; s < segmentCount; ++s)
+  {
+    animation->TotalBezierCount += (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment);
   }
 
 
-  return segment->Evaluate(animation->Points + segment->BasePointIndex, time);
+  InitializeAnimationBezierPolynomials(animation);
+  InitializeAnimationStaticCurves(animation);
 }
 
 
-// -------------- //
-// IMPLEMENTATION //
-// -------------- //
+unsigned int csmGetSerializedSizeofAnimation(const csmAnimation* animation)
+{
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return 0);
+
+
+  return (unsigned int)(sizeof(csmAnimationBlobHeader)
+    + sizeof(csmAnimation)
+    + (sizeof(csmAnimationCurve) * animation->CurveCount)
+    + (sizeof(csmAnimationSegment) * animation->TotalSegmentCount)
+    + (sizeof(csmAnimationPoint) * animation->TotalPointCount)
+    + (sizeof(csmAnimationBezierPolynomial) * animation->TotalBezierCount)
+    + ((animation->BezierTimePolynomialsOffset)
+      ? (sizeof(csmAnimationBezierTimePolynomial) * animation->TotalBezierCount)
+      : 0));
+}
 
-unsigned int csmGetDeserializedSizeofAnimation(const char* motionJson)
+unsigned int csmSerializeAnimation(const csmAnimation* animation, void* address, const unsigned int size)
 {
-  MotionJsonMeta meta;
+  csmAnimationBlobHeader* header;
+  csmAnimation* copy;
+  unsigned int blobSize;
 
 
-  // Validate argument.
-  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
 
 
-  ReadMotionJsonMeta(motionJson, &meta);
+  blobSize = csmGetSerializedSizeofAnimation(animation);
 
 
-  return (unsigned int)(sizeof(csmAnimation)
-    + (sizeof(csmAnimationCurve) * meta.CurveCount)
-    + (sizeof(csmAnimationSegment) * meta.TotalSegmentCount)
-    + (sizeof(csmAnimationPoint) * meta.TotalPointCount));
-}
+  Ensure((blobSize && size >= blobSize), "\"size\" is too small.", return 0);
 
 
-csmAnimation* csmDeserializeAnimationInPlace(const char *motionJson, void* address, const unsigned int size)
-{
-  csmAnimation* animation;
+  // Write header.
+  header = (csmAnimationBlobHeader*)address;
 
 
-  // 'Patch' pointer.
-  animation = (csmAnimation*)address;
+  memcpy(header->Magic, BlobMagic, sizeof(BlobMagic));
 
+  header->Version = BlobVersion;
+  header->ByteOrderMark = BlobByteOrderMark;
+  header->Size = blobSize;
 
-  // Deserialize animation.
-  ReadMotionJson(motionJson, animation);
 
+  // Write animation with data packed behind it.
+  copy = (csmAnimation*)(header + 1);
+  *copy = *animation;
 
-  return animation;
+
+  copy->CurvesOffset = (int)sizeof(csmAnimation);
+  copy->SegmentsOffset = copy->CurvesOffset + (int)(sizeof(csmAnimationCurve) * animation->CurveCount);
+  copy->PointsOffset = copy->SegmentsOffset + (int)(sizeof(csmAnimationSegment) * animation->TotalSegmentCount);
+  copy->BezierPolynomialsOffset = copy->PointsOffset + (int)(sizeof(csmAnimationPoint) * animation->TotalPointCount);
+  copy->BezierTimePolynomialsOffset = (animation->BezierTimePolynomialsOffset)
+    ? copy->BezierPolynomialsOffset + (int)(sizeof(csmAnimationBezierPolynomial) * animation->TotalBezierCount)
+    : 0;
+  copy->LazySourceOffset = 0;
+
+
+  memcpy(GetAnimationCurves(copy), GetAnimationCurves(animation), sizeof(csmAnimationCurve) * animation->CurveCount);
+  memcpy(GetAnimationSegments(copy), GetAnimationSegments(animation), sizeof(csmAnimationSegment) * animation->TotalSegmentCount);
+  memcpy(GetAnimationPoints(copy), GetAnimationPoints(animation), sizeof(csmAnimationPoint) * animation->TotalPointCount);
+  memcpy(GetAnimationBezierPolynomials(copy), GetAnimationBezierPolynomials(animation), sizeof(csmAnimationBezierPolynomial) * animation->TotalBezierCount);
+
+
+  if (animation->BezierTimePolynomialsOffset)
+  {
+    memcpy(GetAnimationBezierTimePolynomials(copy), GetAnimationBezierTimePolynomials(animation), sizeof(csmAnimationBezierTimePolynomial) * animation->TotalBezierCount);
+  }
+
+
+  return blobSize;
 }
 
-void csmInitializeAnimation(csmAnimation* animation,
-                            float duration,
-                            short loop,
-                            csmAnimationCurve* curves, const short curveCount,
-                            csmAnimationSegment* segments,
-                            csmAnimationPoint* points)
+const csmAnimation* csmLoadAnimationFromBlob(const void* blob, const unsigned int size)
 {
+  const csmAnimationBlobHeader* header;
+  const csmAnimation* animation;
+  unsigned int dataSize;
+
+
   // Validate arguments.
-  Ensure(animation, "\"animation\" is invalid.", return);
-  Ensure((duration > 0.0f), "\"duration\" is invalid.", return);
-  Ensure(curves, "\"curves\" are invalid.", return);
-  Ensure((curveCount > 0), "\"curveCount\" is invalid.", return);
-  Ensure(segments, "\"segments\" is invalid.", return);
-  Ensure(points, "\"points\" is invalid.", return);
+  Ensure(blob, "\"blob\" is invalid.", return 0);
+  Ensure(((size_t)blob % sizeof(int)) == 0, "\"blob\" is misaligned.", return 0);
+  Ensure((size >= (sizeof(csmAnimationBlobHeader) + sizeof(csmAnimation))), "\"size\" is too small.", return 0);
 
 
-  // Store   
-  animation->Duration = duration;
-  animation->Loop = loop;
+  // Validate header.
+  header = (const csmAnimationBlobHeader*)blob;
 
-  animation->CurveCount = curveCount;
 
-  animation->Curves = curves;
-  animation->Segments = segments;
-  animation->Points = points;
+  Ensure(memcmp(header->Magic, BlobMagic, sizeof(BlobMagic)) == 0, "Blob isn't an animation.", return 0);
+  Ensure((header->Version == BlobVersion), "Animation blob version is unsupported.", return 0);
+  Ensure((header->ByteOrderMark == BlobByteOrderMark), "Animation blob byte order doesn't match.", return 0);
+  Ensure((header->Size <= size), "Animation blob is truncated.", return 0);
+
+
+  // Validate data extents (without touching data itself so that blob pages are only loaded on demand).
+  animation = (const csmAnimation*)(header + 1);
+  dataSize = header->Size - (unsigned int)sizeof(csmAnimationBlobHeader);
+
+
+  Ensure((IsArrayInBlob(animation->CurvesOffset, animation->CurveCount, sizeof(csmAnimationCurve), dataSize)
+           && IsArrayInBlob(animation->SegmentsOffset, animation->TotalSegmentCount, sizeof(csmAnimationSegment), dataSize)
+           && IsArrayInBlob(animation->PointsOffset, animation->TotalPointCount, sizeof(csmAnimationPoint), dataSize)
+           && IsArrayInBlob(animation->BezierPolynomialsOffset, animation->TotalBezierCount, sizeof(csmAnimationBezierPolynomial), dataSize)
+           && (!animation->BezierTimePolynomialsOffset
+             || IsArrayInBlob(animation->BezierTimePolynomialsOffset, animation->TotalBezierCount, sizeof(csmAnimationBezierTimePolynomial), dataSize))
+           && !animation->LazySourceOffset),
+         "Animation blob is corrupted.",
+         return 0);
+
+
+  return animation;
 }
 
 
@@ -140,7 +1003,7 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
                               void* userData)
 {
   float* parameterValues, * partOpacities;
-  csmAnimationCurve* curves;
+  const csmAnimationCurve* curves;
   float time, value;
   int c, p;
 
@@ -154,19 +1017,10 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
 
 
   // 'Repeat' time as necessary.
-  time = state->Time;
-
-
-  if (animation->Loop)
-  {
-    while (time > animation->Duration)
-    {
-      time -= animation->Duration;
-    }
-  }
+  time = GetAnimationTime(animation, state);
 
 
-  curves = animation->Curves;
+  curves = GetAnimationCurves(animation);
 
 
   // Evaluate model curves.
@@ -180,7 +1034,7 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
 
 
     // Evaluate curve and call handler.
-    value = EvaluateCurve(animation, c , time);
+    value = EvaluateAnimationCurve(animation, c , time, 0);
 
 
     handleModelCurve(model, curves[c].Id, value, userData);
@@ -205,7 +1059,7 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
 
 
     // Evaluate curve and apply value.
-    value = EvaluateCurve(animation, c , time);
+    value = EvaluateAnimationCurve(animation, c , time, 0);
 
     
     parameterValues[p] = blend(parameterValues[p], value, weight);
@@ -230,9 +1084,318 @@ void csmEvaluateAnimationFAST(const csmAnimation *animation,
 
 
     // Evaluate curve and apply value.
-    value = EvaluateCurve(animation, c , time);
+    value = EvaluateAnimationCurve(animation, c , time, 0);
 
     
     partOpacities[p] = blend(partOpacities[p], value, weight);
   }
 }
+
+
+unsigned int csmGetSizeofAnimationBinding(const csmAnimation* animation)
+{
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+
+
+  return (unsigned int)(sizeof(csmAnimationBinding) + (sizeof(csmAnimationCurveBinding) * animation->CurveCount));
+}
+
+csmAnimationBinding* csmBindAnimationInPlace(const csmAnimation* animation,
+                                             const csmModelHashTable* table,
+                                             void* address,
+                                             const unsigned int size)
+{
+  const csmAnimationCurve* curves;
+  csmAnimationBinding* binding;
+  csmAnimationCurveBinding* bound;
+  int c, i;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(table, "\"table\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((size >= csmGetSizeofAnimationBinding(animation)), "\"size\" is invalid.", return 0);
+
+
+  binding = (csmAnimationBinding*)address;
+  binding->ModelCurveCount = 0;
+  binding->ParameterCurveCount = 0;
+  binding->PartOpacityCurveCount = 0;
+  binding->Curves = (csmAnimationCurveBinding*)(binding + 1);
+
+
+  curves = GetAnimationCurves(animation);
+
+
+  // Bind model curves (keeping their order)...
+  bound = binding->Curves;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].Type != csmModelAnimationCurve)
+    {
+      continue;
+    }
+
+
+    bound[binding->ModelCurveCount].CurveIndex = c;
+    bound[binding->ModelCurveCount].TargetIndex = curves[c].Id;
+
+
+    ++binding->ModelCurveCount;
+  }
+
+
+  // ... parameter curves...
+  bound += binding->ModelCurveCount;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].Type != csmParameterAnimationCurve)
+    {
+      continue;
+    }
+
+
+    i = csmFindParameterIndexByHashFAST(table, curves[c].Id);
+
+
+    if (i == -1)
+    {
+      continue;
+    }
+
+
+    InsertCurveBinding(bound, binding->ParameterCurveCount, c, i);
+
+
+    ++binding->ParameterCurveCount;
+  }
+
+
+  // ... and part curves.
+  bound += binding->ParameterCurveCount;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].Type != csmPartOpacityAnimationCurve)
+    {
+      continue;
+    }
+
+
+    i = csmFindPartIndexByHashFAST(table, curves[c].Id);
+
+
+    if (i == -1)
+    {
+      continue;
+    }
+
+
+    InsertCurveBinding(bound, binding->PartOpacityCurveCount, c, i);
+
+
+    ++binding->PartOpacityCurveCount;
+  }
+
+
+  return binding;
+}
+
+csmAnimationBinding* csmBindAnimation(const csmAnimation* animation, const csmModelHashTable* table, csmAllocateFunction allocate)
+{
+  csmAnimationBinding* binding;
+  unsigned int size;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(allocate, "\"allocate\" is invalid.", return 0);
+
+
+  size = csmGetSizeofAnimationBinding(animation);
+  binding = allocate(size);
+
+
+  Ensure(binding, "Failed to allocate animation binding.", return 0);
+
+
+  return csmBindAnimationInPlace(animation, table, binding, size);
+}
+
+
+unsigned int csmGetSizeofAnimationCursor(const csmAnimation* animation)
+{
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+
+
+  return (unsigned int)(sizeof(csmAnimationCursor) + (sizeof(int) * animation->CurveCount));
+}
+
+csmAnimationCursor* csmInitializeAnimationCursorInPlace(const csmAnimation* animation, void* address, const unsigned int size)
+{
+  csmAnimationCursor* cursor;
+  int c;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((size >= csmGetSizeofAnimationCursor(animation)), "\"size\" is invalid.", return 0);
+
+
+  cursor = (csmAnimationCursor*)address;
+  cursor->CurveCount = animation->CurveCount;
+  cursor->SegmentIndices = (int*)(cursor + 1);
+
+
+  for (c = 0; c < cursor->CurveCount; ++c)
+  {
+    cursor->SegmentIndices[c] = 0;
+  }
+
+
+  return cursor;
+}
+
+
+void csmEvaluateBoundAnimation(const csmAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               csmAnimationCursor* cursor,
+                               const csmAnimationState* state,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  float* parameterValues, * partOpacities;
+  int* segmentIndices;
+  float time, value;
+  int b, i;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure((!cursor || cursor->CurveCount == animation->CurveCount), "\"cursor\" doesn't match animation.", return);
+  Ensure(state, "\"state\" is invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  time = GetAnimationTime(animation, state);
+
+
+  segmentIndices = (cursor)
+    ? cursor->SegmentIndices
+    : 0;
+
+
+  // Evaluate model curves.
+  bound = binding->Curves;
+
+
+  for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+  {
+    value = EvaluateAnimationCurve(animation, bound[b].CurveIndex, time, (segmentIndices)
+      ? (segmentIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, value, userData);
+  }
+
+
+  // Evaluate parameter curves (in order of parameters).
+  bound += binding->ModelCurveCount;
+  parameterValues = csmGetParameterValues(model);
+
+
+  for (b = 0; b < binding->ParameterCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateAnimationCurve(animation, bound[b].CurveIndex, time, (segmentIndices)
+      ? (segmentIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    parameterValues[i] = blend(parameterValues[i], value, weight);
+  }
+
+
+  // Evaluate part curves (in order of parts).
+  bound += binding->ParameterCurveCount;
+  partOpacities = csmGetPartOpacities(model);
+
+
+  for (b = 0; b < binding->PartOpacityCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateAnimationCurve(animation, bound[b].CurveIndex, time, (segmentIndices)
+      ? (segmentIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    partOpacities[i] = blend(partOpacities[i], value, weight);
+  }
+}
+
+
+int csmGetBoundAnimationValueCount(const csmAnimationBinding* binding)
+{
+  // Validate argument.
+  Ensure(binding, "\"binding\" is invalid.", return 0);
+
+
+  return binding->ModelCurveCount + binding->ParameterCurveCount + binding->PartOpacityCurveCount;
+}
+
+void csmEvaluateBoundAnimationValues(const csmAnimation* animation,
+                                     const csmAnimationBinding* binding,
+                                     csmAnimationCursor* cursor,
+                                     const csmAnimationState* state,
+                                     float* values)
+{
+  const csmAnimationCurveBinding* bound;
+  int* segmentIndices;
+  float time;
+  int b, count;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure((!cursor || cursor->CurveCount == animation->CurveCount), "\"cursor\" doesn't match animation.", return);
+  Ensure(state, "\"state\" is invalid.", return);
+  Ensure(values, "\"values\" are invalid.", return);
+
+
+  time = GetAnimationTime(animation, state);
+
+
+  segmentIndices = (cursor)
+    ? cursor->SegmentIndices
+    : 0;
+
+
+  // Evaluate all bound curves in order.
+  bound = binding->Curves;
+  count = csmGetBoundAnimationValueCount(binding);
+
+
+  for (b = 0; b < count; ++b)
+  {
+    values[b] = EvaluateAnimationCurve(animation, bound[b].CurveIndex, time, (segmentIndices)
+      ? (segmentIndices + bound[b].CurveIndex)
+      : 0);
+  }
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Subtracts a reference value from all points of a curve.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+/// @param  reference  Value to subtract.
+static void SubtractAnimationCurveReference(csmAnimation* animation, const int index, const float reference)
+{
+  const csmAnimationCurve* curve;
+  csmAnimationPoint* points;
+  int p, basePointIndex, pointCount;
+
+
+  curve = GetAnimationCurves(animation) + index;
+
+
+  // Skip curves referencing points out of range.
+  if (!GetAnimationCurvePointRange(animation, curve, &basePointIndex, &pointCount))
+  {
+    return;
+  }
+
+
+  points = GetAnimationPoints(animation) + basePointIndex;
+
+
+  for (p = 0; p < pointCount; ++p)
+  {
+    points[p].Value -= reference;
+  }
+
+
+  // Keep data derived from points in sync.
+  InitializeAnimationBezierPolynomialRange(animation, curve->BaseSegmentIndex, curve->SegmentCount, curve->BaseBezierIndex);
+  InitializeAnimationStaticCurve(animation, index);
+}
+
+/// Finds the curve of an animation targeting the same value as a curve.
+///
+/// @param  animation  Animation to search.
+/// @param  curve      Curve to match.
+///
+/// @return  Index of matching curve if found; '-1' otherwise.
+static int FindMatchingAnimationCurve(const csmAnimation* animation, const csmAnimationCurve* curve)
+{
+  const csmAnimationCurve* curves;
+  int c;
+
+
+  curves = GetAnimationCurves(animation);
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].Type == curve->Type && curves[c].Id == curve->Id)
+    {
+      return c;
+    }
+  }
+
+
+  return -1;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+void csmMakeAnimationAdditiveToModel(csmAnimation* animation, const csmModel* model)
+{
+  const csmAnimationCurve* curves;
+  const float* defaultValues;
+  int c, p;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  curves = GetAnimationCurves(animation);
+  defaultValues = csmGetParameterDefaultValues(model);
+
+
+  // Convert parameter curves only (as parts don't have defaults).
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].Type != csmParameterAnimationCurve)
+    {
+      continue;
+    }
+
+
+    p = csmFindParameterIndexByHash(model, curves[c].Id);
+
+
+    if (p == -1)
+    {
+      continue;
+    }
+
+
+    SubtractAnimationCurveReference(animation, c, defaultValues[p]);
+  }
+}
+
+void csmMakeAnimationAdditiveToAnimation(csmAnimation* animation, const csmAnimation* reference, const float referenceTime)
+{
+  const csmAnimation* source;
+  const csmAnimationCurve* curves;
+  int c, r;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return);
+
+
+  curves = GetAnimationCurves(animation);
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    // Leave model curves alone (as they drive effects instead of values).
+    if (curves[c].Type == csmModelAnimationCurve)
+    {
+      continue;
+    }
+
+
+    // Fall back to curve itself if reference doesn't animate its target.
+    r = (reference)
+      ? FindMatchingAnimationCurve(reference, curves + c)
+      : -1;
+    source = (r != -1)
+      ? reference
+      : animation;
+
+
+    SubtractAnimationCurveReference(animation, c, EvaluateAnimationCurve(source, (r != -1)
+      ? r
+      : c, referenceTime, 0));
+  }
+}
@@ -0,0 +1,448 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Maximum number of instances evaluated in one batch.
+enum
+{
+  BatchSize = 64
+};
+
+
+/// Linear segments gathered from instances.
+typedef struct LinearSegmentBatch
+{
+  /// Number of gathered segments.
+  int Count;
+
+  /// Instances segments were gathered for.
+  int Lanes[BatchSize];
+
+  /// Times to evaluate at.
+  float Times[BatchSize];
+
+  /// Start times of segments.
+  float StartTimes[BatchSize];
+
+  /// Durations of segments.
+  float Durations[BatchSize];
+
+  /// Start values of segments.
+  float StartValues[BatchSize];
+
+  /// Value deltas of segments.
+  float ValueDeltas[BatchSize];
+}
+LinearSegmentBatch;
+
+/// Restricted bezier segments gathered from instances.
+typedef struct BezierSegmentBatch
+{
+  /// Number of gathered segments.
+  int Count;
+
+  /// Instances segments were gathered for.
+  int Lanes[BatchSize];
+
+  /// Times to evaluate at.
+  float Times[BatchSize];
+
+  /// Start times of segments.
+  float StartTimes[BatchSize];
+
+  /// Inverse durations of segments.
+  float InverseDurations[BatchSize];
+
+  /// Polynomial coefficients of segments (highest order first).
+  float Coefficients[4][BatchSize];
+}
+BezierSegmentBatch;
+
+
+/// Evaluates gathered linear segments.
+///
+/// @param  batch    Segments to evaluate.
+/// @param  results  Values per instance.
+static void EvaluateLinearSegmentBatch(const LinearSegmentBatch* batch, float* results)
+{
+  float values[BatchSize];
+  int s;
+
+
+  s = 0;
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+  for (; (s + 4) <= batch->Count; s += 4)
+  {
+    _mm_storeu_ps(values + s, InterpolateLinearly4(_mm_loadu_ps(batch->StartTimes + s),
+                                                   _mm_loadu_ps(batch->Durations + s),
+                                                   _mm_loadu_ps(batch->StartValues + s),
+                                                   _mm_loadu_ps(batch->ValueDeltas + s),
+                                                   _mm_loadu_ps(batch->Times + s)));
+  }
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+  for (; (s + 4) <= batch->Count; s += 4)
+  {
+    vst1q_f32(values + s, InterpolateLinearly4(vld1q_f32(batch->StartTimes + s),
+                                               vld1q_f32(batch->Durations + s),
+                                               vld1q_f32(batch->StartValues + s),
+                                               vld1q_f32(batch->ValueDeltas + s),
+                                               vld1q_f32(batch->Times + s)));
+  }
+#endif
+
+
+  // Evaluate remaining segments one by one.
+  for (; s < batch->Count; ++s)
+  {
+    values[s] = InterpolateLinearly(batch->StartTimes[s],
+                                    batch->Durations[s],
+                                    batch->StartValues[s],
+                                    batch->ValueDeltas[s],
+                                    batch->Times[s]);
+  }
+
+
+  for (s = 0; s < batch->Count; ++s)
+  {
+    results[batch->Lanes[s]] = values[s];
+  }
+}
+
+/// Evaluates gathered restricted bezier segments.
+///
+/// @param  batch    Segments to evaluate.
+/// @param  results  Values per instance.
+static void EvaluateBezierSegmentBatch(const BezierSegmentBatch* batch, float* results)
+{
+  float values[BatchSize];
+  int s;
+
+
+  s = 0;
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+  {
+    __m128 t;
+
+
+    for (; (s + 4) <= batch->Count; s += 4)
+    {
+      t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(batch->Times + s), _mm_loadu_ps(batch->StartTimes + s)),
+                     _mm_loadu_ps(batch->InverseDurations + s));
+
+
+      _mm_storeu_ps(values + s, EvaluateCubicPolynomial4(_mm_loadu_ps(batch->Coefficients[0] + s),
+                                                         _mm_loadu_ps(batch->Coefficients[1] + s),
+                                                         _mm_loadu_ps(batch->Coefficients[2] + s),
+                                                         _mm_loadu_ps(batch->Coefficients[3] + s),
+                                                         t));
+    }
+  }
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+  {
+    float32x4_t t;
+
+
+    for (; (s + 4) <= batch->Count; s += 4)
+    {
+      t = vmulq_f32(vsubq_f32(vld1q_f32(batch->Times + s), vld1q_f32(batch->StartTimes + s)),
+                    vld1q_f32(batch->InverseDurations + s));
+
+
+      vst1q_f32(values + s, EvaluateCubicPolynomial4(vld1q_f32(batch->Coefficients[0] + s),
+                                                     vld1q_f32(batch->Coefficients[1] + s),
+                                                     vld1q_f32(batch->Coefficients[2] + s),
+                                                     vld1q_f32(batch->Coefficients[3] + s),
+                                                     t));
+    }
+  }
+#endif
+
+
+  // Evaluate remaining segments one by one.
+  for (; s < batch->Count; ++s)
+  {
+    values[s] = EvaluateCubicPolynomial(batch->Coefficients[0][s],
+                                        batch->Coefficients[1][s],
+                                        batch->Coefficients[2][s],
+                                        batch->Coefficients[3][s],
+                                        (batch->Times[s] - batch->StartTimes[s]) * batch->InverseDurations[s]);
+  }
+
+
+  for (s = 0; s < batch->Count; ++s)
+  {
+    results[batch->Lanes[s]] = values[s];
+  }
+}
+
+
+/// Evaluates a curve for a batch of instances.
+///
+/// Segments are looked up per instance and gathered by type, so that segments of the same type are evaluated together.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+/// @param  times      Times to evaluate at (one per instance).
+/// @param  count      Number of instances.
+/// @param  linear     Scratch buffer for linear segments.
+/// @param  bezier     Scratch buffer for bezier segments.
+/// @param  results    Values per instance.
+static void EvaluateCurveBatch(const csmAnimation* animation,
+                               const int index,
+                               const float* times,
+                               const int count,
+                               LinearSegmentBatch* linear,
+                               BezierSegmentBatch* bezier,
+                               float* results)
+{
+  const csmAnimationBezierTimePolynomial* timePolynomials;
+  const csmAnimationBezierPolynomial* polynomial;
+  const csmAnimationSegment* segments, * segment;
+  const csmAnimationPoint* points, * p;
+  const csmAnimationCurve* curve;
+  int l, s, n, b;
+
+
+  DecodeAnimationCurveOnDemand(animation, index);
+
+
+  curve = GetAnimationCurves(animation) + index;
+  segments = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  points = GetAnimationPoints(animation);
+  timePolynomials = GetAnimationBezierTimePolynomials(animation);
+
+
+  linear->Count = 0;
+  bezier->Count = 0;
+
+
+  // Look up segments (hinting each instance with segment of previous one).
+  for (l = 0, s = 0; l < count; ++l)
+  {
+    // Take value of settled curve as is.
+    if (times[l] >= curve->StaticTime)
+    {
+      results[l] = curve->StaticValue;
+
+
+      continue;
+    }
+
+
+    s = FindAnimationSegment(segments, curve->SegmentCount, points, times[l], s);
+    segment = segments + s;
+    p = points + GetAnimationSegmentBasePointIndex(segment);
+
+
+    switch (GetAnimationSegmentType(segment))
+    {
+      case csmLinearAnimationSegment:
+      {
+        n = linear->Count++;
+
+
+        linear->Lanes[n] = l;
+        linear->Times[n] = times[l];
+        linear->StartTimes[n] = p[0].Time;
+        linear->Durations[n] = p[1].Time - p[0].Time;
+        linear->StartValues[n] = p[0].Value;
+        linear->ValueDeltas[n] = p[1].Value - p[0].Value;
+
+
+        break;
+      }
+      case csmBezierAnimationSegment:
+      {
+        b = GetAnimationBezierIndex(animation, curve, curve->BaseSegmentIndex + s);
+        polynomial = GetAnimationBezierPolynomials(animation) + b;
+
+
+        // Solve unrestricted béziers right away.
+        if (timePolynomials)
+        {
+          results[l] = EvaluateUnrestrictedBezierPolynomial(polynomial, timePolynomials + b, times[l]);
+
+
+          break;
+        }
+
+
+        n = bezier->Count++;
+
+
+        bezier->Lanes[n] = l;
+        bezier->Times[n] = times[l];
+        bezier->StartTimes[n] = polynomial->StartTime;
+        bezier->InverseDurations[n] = polynomial->InverseDuration;
+        bezier->Coefficients[0][n] = polynomial->Coefficients[0];
+        bezier->Coefficients[1][n] = polynomial->Coefficients[1];
+        bezier->Coefficients[2][n] = polynomial->Coefficients[2];
+        bezier->Coefficients[3][n] = polynomial->Coefficients[3];
+
+
+        break;
+      }
+      case csmSteppedAnimationSegment:
+      {
+        results[l] = p[0].Value;
+
+
+        break;
+      }
+      default:
+      {
+        results[l] = p[1].Value;
+
+
+        break;
+      }
+    }
+  }
+
+
+  EvaluateLinearSegmentBatch(linear, results);
+  EvaluateBezierSegmentBatch(bezier, results);
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+void csmEvaluateAnimationBatch(const csmAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               const csmAnimationState* states,
+                               csmModel* const* models,
+                               const int count,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData)
+{
+  LinearSegmentBatch linear;
+  BezierSegmentBatch bezier;
+  const csmAnimationCurveBinding* bound;
+  float* targets[BatchSize];
+  float times[BatchSize], values[BatchSize];
+  int first, laneCount, b, i, l;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure((states || count == 0), "\"states\" are invalid.", return);
+  Ensure((models || count == 0), "\"models\" are invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+
+
+  for (i = 0; i < count; ++i)
+  {
+    Ensure(models[i], "\"models\" are invalid.", return);
+  }
+
+
+  // Walk curves once per batch of instances (so that curve data stays in cache).
+  for (first = 0; first < count; first += BatchSize)
+  {
+    laneCount = ((count - first) < BatchSize)
+      ? (count - first)
+      : BatchSize;
+
+
+    for (l = 0; l < laneCount; ++l)
+    {
+      times[l] = GetAnimationTime(animation, states + first + l);
+    }
+
+
+    // Evaluate model curves.
+    bound = binding->Curves;
+
+
+    for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+    {
+      EvaluateCurveBatch(animation, bound[b].CurveIndex, times, laneCount, &linear, &bezier, values);
+
+
+      for (l = 0; l < laneCount; ++l)
+      {
+        handleModelCurve(models[first + l], (csmModelAnimationCurveType)bound[b].TargetIndex, values[l], userData);
+      }
+    }
+
+
+    // Evaluate parameter curves.
+    bound += binding->ModelCurveCount;
+
+
+    for (l = 0; l < laneCount; ++l)
+    {
+      targets[l] = csmGetParameterValues(models[first + l]);
+    }
+
+
+    for (b = 0; b < binding->ParameterCurveCount; ++b)
+    {
+      i = bound[b].TargetIndex;
+
+
+      EvaluateCurveBatch(animation, bound[b].CurveIndex, times, laneCount, &linear, &bezier, values);
+
+
+      for (l = 0; l < laneCount; ++l)
+      {
+        targets[l][i] = blend(targets[l][i], values[l], weight);
+      }
+    }
+
+
+    // Evaluate part curves.
+    bound += binding->ParameterCurveCount;
+
+
+    for (l = 0; l < laneCount; ++l)
+    {
+      targets[l] = csmGetPartOpacities(models[first + l]);
+    }
+
+
+    for (b = 0; b < binding->PartOpacityCurveCount; ++b)
+    {
+      i = bound[b].TargetIndex;
+
+
+      EvaluateCurveBatch(animation, bound[b].CurveIndex, times, laneCount, &linear, &bezier, values);
+
+
+      for (l = 0; l < laneCount; ++l)
+      {
+        targets[l][i] = blend(targets[l][i], values[l], weight);
+      }
+    }
+  }
+}
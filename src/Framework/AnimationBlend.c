@@ -0,0 +1,307 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Blends a value (matching the builtin float blend functions).
+///
+/// @param  base       Current value.
+/// @param  value      Value to blend in.
+/// @param  blendMode  Blend mode.
+/// @param  weight     Blend weight factor.
+///
+/// @return  Blend result.
+static inline float BlendValue(const float base, const float value, const csmAnimationBlendMode blendMode, const float weight)
+{
+  switch (blendMode)
+  {
+    case csmAdditiveAnimationBlend:
+    {
+      return base + (value * weight);
+    }
+    case csmMultiplicativeAnimationBlend:
+    {
+      return base * ((1.0f - weight) + (value * weight));
+    }
+    case csmLerpAnimationBlend:
+    {
+      return (base * (1.0f - weight)) + (value * weight);
+    }
+    default:
+    {
+      return value * weight;
+    }
+  }
+}
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+/// Blends 4 values.
+///
+/// @param  base       Current values.
+/// @param  value      Values to blend in.
+/// @param  blendMode  Blend mode.
+/// @param  weight     Blend weight factor (in all lanes).
+///
+/// @return  Blend results.
+static inline __m128 BlendValues4(const __m128 base, const __m128 value, const csmAnimationBlendMode blendMode, const __m128 weight)
+{
+  switch (blendMode)
+  {
+    case csmAdditiveAnimationBlend:
+    {
+      return _mm_add_ps(base, _mm_mul_ps(value, weight));
+    }
+    case csmMultiplicativeAnimationBlend:
+    {
+      return _mm_mul_ps(base, _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), weight), _mm_mul_ps(value, weight)));
+    }
+    case csmLerpAnimationBlend:
+    {
+      return _mm_add_ps(_mm_mul_ps(base, _mm_sub_ps(_mm_set1_ps(1.0f), weight)), _mm_mul_ps(value, weight));
+    }
+    default:
+    {
+      return _mm_mul_ps(value, weight);
+    }
+  }
+}
+#elif _CSM_COMPONENTS_USE_NEON
+/// Blends 4 values.
+///
+/// @param  base       Current values.
+/// @param  value      Values to blend in.
+/// @param  blendMode  Blend mode.
+/// @param  weight     Blend weight factor (in all lanes).
+///
+/// @return  Blend results.
+static inline float32x4_t BlendValues4(const float32x4_t base, const float32x4_t value, const csmAnimationBlendMode blendMode, const float32x4_t weight)
+{
+  // Multiply and add separately (as fused instructions would round differently than scalar code).
+  switch (blendMode)
+  {
+    case csmAdditiveAnimationBlend:
+    {
+      return vaddq_f32(base, vmulq_f32(value, weight));
+    }
+    case csmMultiplicativeAnimationBlend:
+    {
+      return vmulq_f32(base, vaddq_f32(vsubq_f32(vdupq_n_f32(1.0f), weight), vmulq_f32(value, weight)));
+    }
+    case csmLerpAnimationBlend:
+    {
+      return vaddq_f32(vmulq_f32(base, vsubq_f32(vdupq_n_f32(1.0f), weight)), vmulq_f32(value, weight));
+    }
+    default:
+    {
+      return vmulq_f32(value, weight);
+    }
+  }
+}
+#endif
+
+
+/// Blends values into targets through bound curves one by one.
+///
+/// @param  targets    Values to blend into.
+/// @param  bound      Bound curves of values.
+/// @param  values     Values to blend in.
+/// @param  count      Number of values.
+/// @param  blendMode  Blend mode.
+/// @param  weight     Blend weight factor.
+static void BlendBoundValuesOneByOne(float* targets,
+                                     const csmAnimationCurveBinding* bound,
+                                     const float* values,
+                                     const int count,
+                                     const csmAnimationBlendMode blendMode,
+                                     const float weight)
+{
+  int b;
+
+
+  for (b = 0; b < count; ++b)
+  {
+    targets[bound[b].TargetIndex] = BlendValue(targets[bound[b].TargetIndex], values[b], blendMode, weight);
+  }
+}
+
+
+#if _CSM_COMPONENTS_USE_SSE2 || _CSM_COMPONENTS_USE_NEON
+/// Checks whether 4 bound curves target different values.
+///
+/// Bound curves are sorted by target, so curves sharing a target are adjacent.
+///
+/// @param  bound  Bound curves to check.
+///
+/// @return  Non-zero if targets are distinct; '0' otherwise.
+static inline int AreBoundTargetsDistinct4(const csmAnimationCurveBinding* bound)
+{
+  return bound[0].TargetIndex != bound[1].TargetIndex
+    && bound[1].TargetIndex != bound[2].TargetIndex
+    && bound[2].TargetIndex != bound[3].TargetIndex;
+}
+#endif
+
+
+/// Blends values into targets through bound curves.
+///
+/// Targets are gathered and scattered one by one, as bound targets needn't be contiguous.
+/// Groups with curves sharing a target are blended one by one, as scattering would drop all but one contribution.
+///
+/// @param  targets    Values to blend into.
+/// @param  bound      Bound curves of values.
+/// @param  values     Values to blend in.
+/// @param  count      Number of values.
+/// @param  blendMode  Blend mode.
+/// @param  weight     Blend weight factor.
+static void BlendBoundValues(float* targets,
+                             const csmAnimationCurveBinding* bound,
+                             const float* values,
+                             const int count,
+                             const csmAnimationBlendMode blendMode,
+                             const float weight)
+{
+  int b;
+
+
+  b = 0;
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+  {
+    float results[4];
+    __m128 base;
+
+
+    for (; (b + 4) <= count; b += 4)
+    {
+      if (!AreBoundTargetsDistinct4(bound + b))
+      {
+        BlendBoundValuesOneByOne(targets, bound + b, values + b, 4, blendMode, weight);
+
+
+        continue;
+      }
+
+
+      base = _mm_set_ps(targets[bound[b + 3].TargetIndex],
+                        targets[bound[b + 2].TargetIndex],
+                        targets[bound[b + 1].TargetIndex],
+                        targets[bound[b].TargetIndex]);
+
+
+      _mm_storeu_ps(results, BlendValues4(base, _mm_loadu_ps(values + b), blendMode, _mm_set1_ps(weight)));
+
+
+      targets[bound[b].TargetIndex] = results[0];
+      targets[bound[b + 1].TargetIndex] = results[1];
+      targets[bound[b + 2].TargetIndex] = results[2];
+      targets[bound[b + 3].TargetIndex] = results[3];
+    }
+  }
+#elif _CSM_COMPONENTS_USE_NEON
+  {
+    float bases[4], results[4];
+
+
+    for (; (b + 4) <= count; b += 4)
+    {
+      if (!AreBoundTargetsDistinct4(bound + b))
+      {
+        BlendBoundValuesOneByOne(targets, bound + b, values + b, 4, blendMode, weight);
+
+
+        continue;
+      }
+
+
+      bases[0] = targets[bound[b].TargetIndex];
+      bases[1] = targets[bound[b + 1].TargetIndex];
+      bases[2] = targets[bound[b + 2].TargetIndex];
+      bases[3] = targets[bound[b + 3].TargetIndex];
+
+
+      vst1q_f32(results, BlendValues4(vld1q_f32(bases), vld1q_f32(values + b), blendMode, vdupq_n_f32(weight)));
+
+
+      targets[bound[b].TargetIndex] = results[0];
+      targets[bound[b + 1].TargetIndex] = results[1];
+      targets[bound[b + 2].TargetIndex] = results[2];
+      targets[bound[b + 3].TargetIndex] = results[3];
+    }
+  }
+#endif
+
+
+  // Blend remaining values one by one.
+  BlendBoundValuesOneByOne(targets, bound + b, values + b, count - b, blendMode, weight);
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+void csmBlendBoundAnimationValues(const csmAnimationBinding* binding,
+                                  const float* values,
+                                  const csmAnimationBlendMode blendMode,
+                                  const float weight,
+                                  csmModel* model,
+                                  csmModelAnimationCurveHandler handleModelCurve,
+                                  void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  int b;
+
+
+  // Validate arguments.
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure(values, "\"values\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  // Pass model curves on.
+  bound = binding->Curves;
+
+
+  for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+  {
+    handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, values[b], userData);
+  }
+
+
+  // Blend parameter curves...
+  bound += binding->ModelCurveCount;
+  values += binding->ModelCurveCount;
+
+
+  BlendBoundValues(csmGetParameterValues(model), bound, values, binding->ParameterCurveCount, blendMode, weight);
+
+
+  // ... and part curves.
+  bound += binding->ParameterCurveCount;
+  values += binding->ParameterCurveCount;
+
+
+  BlendBoundValues(csmGetPartOpacities(model), bound, values, binding->PartOpacityCurveCount, blendMode, weight);
+}
@@ -0,0 +1,597 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Gets the number of hash slots of a pool (keeping the load factor at most one half).
+///
+/// @param  curveCount  Maximum number of curves of pool.
+///
+/// @return  Number of hash slots.
+static int GetHashSlotCount(const int curveCount)
+{
+  int slotCount;
+
+
+  slotCount = 1;
+
+
+  while (slotCount < (curveCount * 2))
+  {
+    slotCount *= 2;
+  }
+
+
+  return slotCount;
+}
+
+/// Computes the size of an animation curve pool.
+///
+/// @param  animationCount  Maximum number of pooled animations.
+/// @param  curveCount      Maximum number of curves of all pooled animations.
+/// @param  segmentCount    Maximum number of segments of unique curves.
+/// @param  bezierCount     Maximum number of bezier segments of unique curves.
+/// @param  pointCount      Maximum number of points of unique curves.
+///
+/// @return  Number of bytes necessary.
+static unsigned long long GetSizeofAnimationCurvePool(const int animationCount,
+                                                      const int curveCount,
+                                                      const int segmentCount,
+                                                      const int bezierCount,
+                                                      const int pointCount)
+{
+  return sizeof(csmAnimationCurvePool)
+    + (sizeof(csmAnimationPooledCurve) * (unsigned long long)curveCount)
+    + (sizeof(int) * (unsigned long long)GetHashSlotCount(curveCount))
+    + (sizeof(csmAnimationSegment) * (unsigned long long)segmentCount)
+    + (sizeof(csmAnimationPoint) * (unsigned long long)pointCount)
+    + (sizeof(csmAnimationBezierPolynomial) * (unsigned long long)bezierCount)
+    + (sizeof(csmAnimationBezierTimePolynomial) * (unsigned long long)bezierCount)
+    + (sizeof(csmAnimation) * (unsigned long long)animationCount)
+    + (sizeof(csmAnimationCurve) * (unsigned long long)curveCount);
+}
+
+/// Gets the size of the data of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Number of bytes of animation.
+static unsigned int GetSizeofAnimationData(const csmAnimation* animation)
+{
+  return (unsigned int)(sizeof(csmAnimation)
+    + (sizeof(csmAnimationCurve) * animation->CurveCount)
+    + (sizeof(csmAnimationSegment) * animation->TotalSegmentCount)
+    + (sizeof(csmAnimationPoint) * animation->TotalPointCount)
+    + (sizeof(csmAnimationBezierPolynomial) * animation->TotalBezierCount)
+    + ((animation->BezierTimePolynomialsOffset)
+      ? (sizeof(csmAnimationBezierTimePolynomial) * animation->TotalBezierCount)
+      : 0));
+}
+
+
+/// Hashes the content of a curve (with point indices relative to its first point).
+///
+/// @param  segments        Segments of curve.
+/// @param  segmentCount    Number of segments.
+/// @param  points          Points of curve.
+/// @param  basePointIndex  Index of first point of curve.
+/// @param  pointCount      Number of points of curve.
+///
+/// @return  Hash.
+static unsigned int HashCurve(const csmAnimationSegment* segments,
+                              const int segmentCount,
+                              const csmAnimationPoint* points,
+                              const int basePointIndex,
+                              const int pointCount)
+{
+  unsigned int hash, word;
+  int s, p;
+
+
+  // Hash words FNV-1a style.
+  hash = 2166136261u;
+  hash = (hash ^ (unsigned int)segmentCount) * 16777619u;
+
+
+  for (s = 0; s < segmentCount; ++s)
+  {
+    hash = (hash ^ (segments[s].TypeAndBasePointIndex - (unsigned int)basePointIndex)) * 16777619u;
+  }
+
+
+  for (p = 0; p < pointCount; ++p)
+  {
+    memcpy(&word, &points[basePointIndex + p].Time, sizeof(word));
+    hash = (hash ^ word) * 16777619u;
+
+
+    memcpy(&word, &points[basePointIndex + p].Value, sizeof(word));
+    hash = (hash ^ word) * 16777619u;
+  }
+
+
+  return hash;
+}
+
+/// Counts the bezier segments of a curve.
+///
+/// @param  segments      Segments of curve.
+/// @param  segmentCount  Number of segments.
+///
+/// @return  Number of bezier segments.
+static int CountBezierSegments(const csmAnimationSegment* segments, const int segmentCount)
+{
+  int s, bezierCount;
+
+
+  bezierCount = 0;
+
+
+  for (s = 0; s < segmentCount; ++s)
+  {
+    bezierCount += (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment);
+  }
+
+
+  return bezierCount;
+}
+
+/// Checks whether a unique curve of a pool is byte-identical to a curve.
+///
+/// @param  pool            Pool containing unique curve.
+/// @param  pooled          Unique curve to compare.
+/// @param  segments        Segments of curve.
+/// @param  segmentCount    Number of segments.
+/// @param  points          Points of curve.
+/// @param  basePointIndex  Index of first point of curve.
+/// @param  pointCount      Number of points of curve.
+///
+/// @return  Non-zero if curves match; '0' otherwise.
+static int DoesPooledCurveMatch(const csmAnimationCurvePool* pool,
+                                const csmAnimationPooledCurve* pooled,
+                                const csmAnimationSegment* segments,
+                                const int segmentCount,
+                                const csmAnimationPoint* points,
+                                const int basePointIndex,
+                                const int pointCount)
+{
+  const csmAnimationSegment* pooledSegments;
+  int s;
+
+
+  if (pooled->SegmentCount != segmentCount || pooled->PointCount != pointCount)
+  {
+    return 0;
+  }
+
+
+  pooledSegments = GetAnimationSegments(&pool->Storage) + pooled->BaseSegmentIndex;
+
+
+  for (s = 0; s < segmentCount; ++s)
+  {
+    if ((pooledSegments[s].TypeAndBasePointIndex - (unsigned int)pooled->BasePointIndex)
+      != (segments[s].TypeAndBasePointIndex - (unsigned int)basePointIndex))
+    {
+      return 0;
+    }
+  }
+
+
+  return !memcmp(GetAnimationPoints(&pool->Storage) + pooled->BasePointIndex,
+                 points + basePointIndex,
+                 sizeof(csmAnimationPoint) * (size_t)pointCount);
+}
+
+/// Finds the hash slot of a curve.
+///
+/// @param  pool       Pool to search.
+/// @param  animation  Animation containing curve.
+/// @param  curve      Curve to find.
+/// @param  hash       Hash of curve.
+///
+/// @return  Slot holding a matching unique curve if curve is pooled already; empty slot to insert curve into otherwise.
+static int FindCurveHashSlot(const csmAnimationCurvePool* pool, const csmAnimation* animation, const csmAnimationCurve* curve, const unsigned int hash)
+{
+  const csmAnimationPooledCurve* pooled;
+  int slot, basePointIndex, pointCount;
+
+
+  GetAnimationCurvePointRange(animation, curve, &basePointIndex, &pointCount);
+
+
+  // Probe linearly.
+  for (slot = (int)(hash & (unsigned int)(pool->HashSlotCount - 1)); pool->HashSlots[slot] != -1; slot = (slot + 1) & (pool->HashSlotCount - 1))
+  {
+    pooled = pool->UniqueCurves + pool->HashSlots[slot];
+
+
+    if (pooled->Hash == hash
+      && DoesPooledCurveMatch(pool,
+                              pooled,
+                              GetAnimationSegments(animation) + curve->BaseSegmentIndex,
+                              curve->SegmentCount,
+                              GetAnimationPoints(animation),
+                              basePointIndex,
+                              pointCount))
+    {
+      break;
+    }
+  }
+
+
+  return slot;
+}
+
+/// Hashes a curve of an animation.
+///
+/// @param  animation  Animation containing curve.
+/// @param  curve      Curve to hash (referencing segments and points in range).
+///
+/// @return  Hash.
+static unsigned int HashAnimationCurve(const csmAnimation* animation, const csmAnimationCurve* curve)
+{
+  int basePointIndex, pointCount;
+
+
+  GetAnimationCurvePointRange(animation, curve, &basePointIndex, &pointCount);
+
+
+  return HashCurve(GetAnimationSegments(animation) + curve->BaseSegmentIndex,
+                   curve->SegmentCount,
+                   GetAnimationPoints(animation),
+                   basePointIndex,
+                   pointCount);
+}
+
+
+/// Stores a curve in a pool.
+///
+/// @param  pool       Pool to store curve in (with room for curve).
+/// @param  animation  Animation containing curve.
+/// @param  curve      Curve to store.
+/// @param  hash       Hash of curve.
+/// @param  slot       Empty hash slot to insert curve into.
+///
+/// @return  Index of unique curve.
+static int StorePooledCurve(csmAnimationCurvePool* pool,
+                            const csmAnimation* animation,
+                            const csmAnimationCurve* curve,
+                            const unsigned int hash,
+                            const int slot)
+{
+  const csmAnimationSegment* segments;
+  csmAnimationSegment* pooledSegments;
+  csmAnimationPooledCurve* pooled;
+  int s, basePointIndex, pointCount;
+
+
+  GetAnimationCurvePointRange(animation, curve, &basePointIndex, &pointCount);
+
+
+  pooled = pool->UniqueCurves + pool->UniqueCurveCount;
+  pooled->Hash = hash;
+  pooled->SegmentCount = curve->SegmentCount;
+  pooled->BaseSegmentIndex = pool->Storage.TotalSegmentCount;
+  pooled->BasePointIndex = pool->Storage.TotalPointCount;
+  pooled->PointCount = pointCount;
+  pooled->BaseBezierIndex = pool->Storage.TotalBezierCount;
+
+
+  // Copy points and segments (rebasing point indices onto storage).
+  memcpy(GetAnimationPoints(&pool->Storage) + pooled->BasePointIndex,
+         GetAnimationPoints(animation) + basePointIndex,
+         sizeof(csmAnimationPoint) * (size_t)pointCount);
+
+
+  segments = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  pooledSegments = GetAnimationSegments(&pool->Storage) + pooled->BaseSegmentIndex;
+
+
+  for (s = 0; s < curve->SegmentCount; ++s)
+  {
+    InitializeAnimationSegment(pooledSegments + s,
+                               GetAnimationSegmentType(segments + s),
+                               pooled->BasePointIndex + (GetAnimationSegmentBasePointIndex(segments + s) - basePointIndex));
+  }
+
+
+  pool->Storage.TotalSegmentCount += curve->SegmentCount;
+  pool->Storage.TotalPointCount += pointCount;
+  pool->Storage.TotalBezierCount += CountBezierSegments(segments, curve->SegmentCount);
+
+
+  // Compute polynomials (including time polynomials, so that animations with unrestricted béziers can share the curve, too).
+  InitializeAnimationBezierPolynomialRange(&pool->Storage, pooled->BaseSegmentIndex, pooled->SegmentCount, pooled->BaseBezierIndex);
+
+
+  pool->HashSlots[slot] = pool->UniqueCurveCount;
+  pool->UniqueCurveCount += 1;
+
+
+  return pool->UniqueCurveCount - 1;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationCurvePool(const int animationCount,
+                                            const int curveCount,
+                                            const int segmentCount,
+                                            const int bezierCount,
+                                            const int pointCount)
+{
+  unsigned long long size;
+
+
+  // Validate arguments.
+  Ensure((animationCount > 0), "\"animationCount\" is invalid.", return 0);
+  Ensure((curveCount >= 0 && curveCount <= (INT_MAX / 2)), "\"curveCount\" is invalid.", return 0);
+  Ensure((segmentCount >= 0), "\"segmentCount\" is invalid.", return 0);
+  Ensure((bezierCount >= 0), "\"bezierCount\" is invalid.", return 0);
+  Ensure((pointCount >= 0 && pointCount <= (int)csmAnimationSegmentBasePointIndexMask), "\"pointCount\" is invalid.", return 0);
+
+
+  size = GetSizeofAnimationCurvePool(animationCount, curveCount, segmentCount, bezierCount, pointCount);
+
+
+  // Keep offsets of pooled animations in range.
+  Ensure((size <= INT_MAX), "Animation curve pool is too big.", return 0);
+
+
+  return (unsigned int)size;
+}
+
+csmAnimationCurvePool* csmInitializeAnimationCurvePoolInPlace(const int animationCount,
+                                                              const int curveCount,
+                                                              const int segmentCount,
+                                                              const int bezierCount,
+                                                              const int pointCount,
+                                                              void* address,
+                                                              const unsigned int size)
+{
+  csmAnimationCurvePool* pool;
+  unsigned int requiredSize;
+  char* next;
+  int h;
+
+
+  // Validate arguments.
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure(((size_t)address % sizeof(void*)) == 0, "\"address\" is misaligned.", return 0);
+
+
+  requiredSize = csmGetSizeofAnimationCurvePool(animationCount, curveCount, segmentCount, bezierCount, pointCount);
+
+
+  Ensure((requiredSize && size >= requiredSize), "\"size\" is invalid.", return 0);
+
+
+  // Initialize fields.
+  pool = (csmAnimationCurvePool*)address;
+
+
+  pool->AnimationCapacity = animationCount;
+  pool->AnimationCount = 0;
+  pool->CurveCapacity = curveCount;
+  pool->CurveCount = 0;
+  pool->UniqueCurveCount = 0;
+  pool->SegmentCapacity = segmentCount;
+  pool->PointCapacity = pointCount;
+  pool->BezierCapacity = bezierCount;
+  pool->HashSlotCount = GetHashSlotCount(curveCount);
+  pool->AnimationsSize = 0;
+  pool->SourceSize = 0;
+
+
+  next = (char*)(pool + 1);
+
+
+  pool->UniqueCurves = (csmAnimationPooledCurve*)next;
+  next += sizeof(csmAnimationPooledCurve) * curveCount;
+
+
+  pool->HashSlots = (int*)next;
+  next += sizeof(int) * pool->HashSlotCount;
+
+
+  for (h = 0; h < pool->HashSlotCount; ++h)
+  {
+    pool->HashSlots[h] = -1;
+  }
+
+
+  // Initialize storage (relative to itself like any animation).
+  pool->Storage.Duration = 0.0f;
+  pool->Storage.Fps = 0.0f;
+  pool->Storage.Loop = 0;
+  pool->Storage.CurveCount = 0;
+  pool->Storage.TotalSegmentCount = 0;
+  pool->Storage.TotalPointCount = 0;
+  pool->Storage.TotalBezierCount = 0;
+  pool->Storage.CurvesOffset = (int)sizeof(csmAnimation);
+  pool->Storage.LazySourceOffset = 0;
+
+
+  pool->Storage.SegmentsOffset = (int)(next - (char*)&pool->Storage);
+  next += sizeof(csmAnimationSegment) * segmentCount;
+
+
+  pool->Storage.PointsOffset = (int)(next - (char*)&pool->Storage);
+  next += sizeof(csmAnimationPoint) * pointCount;
+
+
+  pool->Storage.BezierPolynomialsOffset = (int)(next - (char*)&pool->Storage);
+  next += sizeof(csmAnimationBezierPolynomial) * bezierCount;
+
+
+  pool->Storage.BezierTimePolynomialsOffset = (int)(next - (char*)&pool->Storage);
+  next += sizeof(csmAnimationBezierTimePolynomial) * bezierCount;
+
+
+  pool->Animations = next;
+
+
+  return pool;
+}
+
+
+const csmAnimation* csmAddAnimationToCurvePool(csmAnimationCurvePool* pool, const csmAnimation* animation)
+{
+  const csmAnimationPooledCurve* unique;
+  const csmAnimationCurve* curves;
+  csmAnimationCurve* pooledCurves;
+  csmAnimation* pooled;
+  unsigned int hash;
+  int c, slot, basePointIndex, pointCount, segmentCount, bezierCount, totalPointCount;
+
+
+  // Validate arguments.
+  Ensure(pool, "\"pool\" is invalid.", return 0);
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return 0);
+  Ensure((pool->AnimationCount < pool->AnimationCapacity), "Animation curve pool is out of animations.", return 0);
+  Ensure((animation->CurveCount <= (pool->CurveCapacity - pool->CurveCount)), "Animation curve pool is out of curves.", return 0);
+
+
+  curves = GetAnimationCurves(animation);
+
+
+  // Make sure curves not pooled yet fit (counting curves repeated within animation more than once).
+  segmentCount = pool->Storage.TotalSegmentCount;
+  bezierCount = pool->Storage.TotalBezierCount;
+  totalPointCount = pool->Storage.TotalPointCount;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].SegmentCount == 0)
+    {
+      continue;
+    }
+
+
+    Ensure(GetAnimationCurvePointRange(animation, curves + c, &basePointIndex, &pointCount), "\"animation\" is invalid.", return 0);
+
+
+    if (pool->HashSlots[FindCurveHashSlot(pool, animation, curves + c, HashAnimationCurve(animation, curves + c))] != -1)
+    {
+      continue;
+    }
+
+
+    segmentCount += curves[c].SegmentCount;
+    bezierCount += CountBezierSegments(GetAnimationSegments(animation) + curves[c].BaseSegmentIndex, curves[c].SegmentCount);
+    totalPointCount += pointCount;
+  }
+
+
+  Ensure((segmentCount <= pool->SegmentCapacity), "Animation curve pool is out of segments.", return 0);
+  Ensure((bezierCount <= pool->BezierCapacity), "Animation curve pool is out of béziers.", return 0);
+  Ensure((totalPointCount <= pool->PointCapacity), "Animation curve pool is out of points.", return 0);
+
+
+  // Place animation...
+  pooled = (csmAnimation*)(pool->Animations + pool->AnimationsSize);
+  pooledCurves = (csmAnimationCurve*)(pooled + 1);
+
+
+  // ... and point its curves at unique ones.
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    pooledCurves[c] = curves[c];
+
+
+    if (curves[c].SegmentCount == 0)
+    {
+      pooledCurves[c].BaseSegmentIndex = 0;
+      pooledCurves[c].BaseBezierIndex = 0;
+
+
+      continue;
+    }
+
+
+    hash = HashAnimationCurve(animation, curves + c);
+    slot = FindCurveHashSlot(pool, animation, curves + c, hash);
+
+
+    unique = pool->UniqueCurves + ((pool->HashSlots[slot] != -1)
+      ? pool->HashSlots[slot]
+      : StorePooledCurve(pool, animation, curves + c, hash, slot));
+
+
+    pooledCurves[c].BaseSegmentIndex = unique->BaseSegmentIndex;
+    pooledCurves[c].BaseBezierIndex = unique->BaseBezierIndex;
+  }
+
+
+  // Reference pool storage.
+  pooled->Duration = animation->Duration;
+  pooled->Fps = animation->Fps;
+  pooled->Loop = animation->Loop;
+  pooled->CurveCount = animation->CurveCount;
+  pooled->TotalSegmentCount = pool->Storage.TotalSegmentCount;
+  pooled->TotalPointCount = pool->Storage.TotalPointCount;
+  pooled->TotalBezierCount = pool->Storage.TotalBezierCount;
+  pooled->CurvesOffset = (int)sizeof(csmAnimation);
+  pooled->SegmentsOffset = (int)((char*)GetAnimationSegments(&pool->Storage) - (char*)pooled);
+  pooled->PointsOffset = (int)((char*)GetAnimationPoints(&pool->Storage) - (char*)pooled);
+  pooled->BezierPolynomialsOffset = (int)((char*)GetAnimationBezierPolynomials(&pool->Storage) - (char*)pooled);
+  pooled->BezierTimePolynomialsOffset = (animation->BezierTimePolynomialsOffset)
+    ? (int)((char*)GetAnimationBezierTimePolynomials(&pool->Storage) - (char*)pooled)
+    : 0;
+  pooled->LazySourceOffset = 0;
+
+
+  // Update bookkeeping.
+  pool->AnimationCount += 1;
+  pool->CurveCount += animation->CurveCount;
+  pool->AnimationsSize += (unsigned int)(sizeof(csmAnimation) + (sizeof(csmAnimationCurve) * animation->CurveCount));
+  pool->SourceSize += GetSizeofAnimationData(animation);
+
+
+  return pooled;
+}
+
+void csmGetAnimationCurvePoolStatistics(const csmAnimationCurvePool* pool, csmAnimationCurvePoolStatistics* statistics)
+{
+  // Validate arguments.
+  Ensure(pool, "\"pool\" is invalid.", return);
+  Ensure(statistics, "\"statistics\" is invalid.", return);
+
+
+  statistics->AnimationCount = pool->AnimationCount;
+  statistics->CurveCount = pool->CurveCount;
+  statistics->UniqueCurveCount = pool->UniqueCurveCount;
+  statistics->SourceSize = pool->SourceSize;
+  statistics->PooledSize = pool->AnimationsSize
+    + (unsigned int)(sizeof(csmAnimationPooledCurve) * pool->UniqueCurveCount)
+    + (unsigned int)(sizeof(csmAnimationSegment) * pool->Storage.TotalSegmentCount)
+    + (unsigned int)((sizeof(csmAnimationBezierPolynomial) + sizeof(csmAnimationBezierTimePolynomial)) * pool->Storage.TotalBezierCount)
+    + (unsigned int)(sizeof(csmAnimationPoint) * pool->Storage.TotalPointCount);
+}
@@ -0,0 +1,295 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+#include <limits.h>
+#include <math.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Quantizes a time to the resolution of a cache.
+///
+/// @param  cache  Cache to quantize for.
+/// @param  time   Time to quantize.
+///
+/// @return  Quantized time.
+static inline float QuantizeTime(const csmAnimationEvaluationCache* cache, const float time)
+{
+  return (cache->TimeResolution > 0.0f)
+    ? (floorf((time / cache->TimeResolution) + 0.5f) * cache->TimeResolution)
+    : time;
+}
+
+
+/// Finds a cache entry.
+///
+/// @param  cache      Cache to search.
+/// @param  animation  Animation of entry.
+/// @param  time       Quantized time of entry.
+///
+/// @return  Entry if cached; '0' otherwise.
+static csmAnimationEvaluationCacheEntry* FindCacheEntry(const csmAnimationEvaluationCache* cache,
+                                                        const csmAnimation* animation,
+                                                        const float time)
+{
+  int e;
+
+
+  // Search linearly (as there are few unique playheads per frame).
+  for (e = 0; e < cache->EntryCount; ++e)
+  {
+    if (cache->Entries[e].Animation == animation && cache->Entries[e].Time == time)
+    {
+      return cache->Entries + e;
+    }
+  }
+
+
+  return 0;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationEvaluationCache(const int curveCount, const int entryCount)
+{
+  unsigned long long size;
+
+
+  // Validate arguments.
+  Ensure((curveCount >= 0), "\"curveCount\" is invalid.", return 0);
+  Ensure((entryCount > 0), "\"entryCount\" is invalid.", return 0);
+
+
+  size = sizeof(csmAnimationEvaluationCache)
+    + (sizeof(csmAnimationEvaluationCacheEntry) * (unsigned long long)entryCount)
+    + (sizeof(float) * (unsigned long long)curveCount * (unsigned long long)entryCount);
+
+
+  Ensure((size <= UINT_MAX), "Animation evaluation cache is too big.", return 0);
+
+
+  return (unsigned int)size;
+}
+
+csmAnimationEvaluationCache* csmInitializeAnimationEvaluationCacheInPlace(const int curveCount,
+                                                                          const int entryCount,
+                                                                          const float timeResolution,
+                                                                          void* address,
+                                                                          const unsigned int size)
+{
+  csmAnimationEvaluationCache* cache;
+  unsigned int requiredSize;
+  float* values;
+  int e;
+
+
+  // Validate arguments.
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((timeResolution >= 0.0f), "\"timeResolution\" is invalid.", return 0);
+
+
+  requiredSize = csmGetSizeofAnimationEvaluationCache(curveCount, entryCount);
+
+
+  Ensure((requiredSize && size >= requiredSize), "\"size\" is invalid.", return 0);
+
+
+  // Initialize fields.
+  cache = (csmAnimationEvaluationCache*)address;
+
+
+  cache->CurveCount = curveCount;
+  cache->EntryCount = entryCount;
+  cache->TimeResolution = timeResolution;
+  cache->Entries = (csmAnimationEvaluationCacheEntry*)(cache + 1);
+
+
+  values = (float*)(cache->Entries + entryCount);
+
+
+  for (e = 0; e < entryCount; ++e)
+  {
+    cache->Entries[e].Values = values + (e * curveCount);
+  }
+
+
+  csmResetAnimationEvaluationCache(cache);
+
+
+  return cache;
+}
+
+void csmResetAnimationEvaluationCache(csmAnimationEvaluationCache* cache)
+{
+  int e;
+
+
+  // Validate argument.
+  Ensure(cache, "\"cache\" is invalid.", return);
+
+
+  for (e = 0; e < cache->EntryCount; ++e)
+  {
+    cache->Entries[e].Animation = 0;
+    cache->Entries[e].Time = 0.0f;
+  }
+
+
+  cache->NextEntryIndex = 0;
+}
+
+void csmDropCachedAnimationValues(csmAnimationEvaluationCache* cache, const csmAnimation* animation)
+{
+  int e;
+
+
+  // Validate arguments.
+  Ensure(cache, "\"cache\" is invalid.", return);
+  Ensure(animation, "\"animation\" is invalid.", return);
+
+
+  for (e = 0; e < cache->EntryCount; ++e)
+  {
+    if (cache->Entries[e].Animation == animation)
+    {
+      cache->Entries[e].Animation = 0;
+      cache->Entries[e].Time = 0.0f;
+    }
+  }
+}
+
+
+const float* csmGetCachedAnimationValues(csmAnimationEvaluationCache* cache,
+                                         const csmAnimation* animation,
+                                         const csmAnimationState* state)
+{
+  csmAnimationEvaluationCacheEntry* entry;
+  float time;
+  int c;
+
+
+  // Validate arguments.
+  Ensure(cache, "\"cache\" is invalid.", return 0);
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure((animation->CurveCount <= cache->CurveCount), "\"animation\" has too many curves for cache.", return 0);
+  Ensure(state, "\"state\" is invalid.", return 0);
+
+
+  time = QuantizeTime(cache, GetAnimationTime(animation, state));
+  entry = FindCacheEntry(cache, animation, time);
+
+
+  if (entry)
+  {
+    return entry->Values;
+  }
+
+
+  // Replace entries in order of insertion.
+  entry = cache->Entries + cache->NextEntryIndex;
+  cache->NextEntryIndex = (cache->NextEntryIndex + 1) % cache->EntryCount;
+
+
+  entry->Animation = animation;
+  entry->Time = time;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    entry->Values[c] = EvaluateAnimationCurve(animation, c, time, 0);
+  }
+
+
+  return entry->Values;
+}
+
+void csmEvaluateCachedAnimation(csmAnimationEvaluationCache* cache,
+                                const csmAnimation* animation,
+                                const csmAnimationBinding* binding,
+                                const csmAnimationState* state,
+                                const csmFloatBlendFunction blend,
+                                const float weight,
+                                csmModel* model,
+                                csmModelAnimationCurveHandler handleModelCurve,
+                                void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  float* parameterValues, * partOpacities;
+  const float* values;
+  int b, i;
+
+
+  // Validate arguments.
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  values = csmGetCachedAnimationValues(cache, animation, state);
+
+
+  if (!values)
+  {
+    return;
+  }
+
+
+  // Pass model curves on.
+  bound = binding->Curves;
+
+
+  for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+  {
+    handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, values[bound[b].CurveIndex], userData);
+  }
+
+
+  // Blend parameter curves...
+  bound += binding->ModelCurveCount;
+  parameterValues = csmGetParameterValues(model);
+
+
+  for (b = 0; b < binding->ParameterCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+
+
+    parameterValues[i] = blend(parameterValues[i], values[bound[b].CurveIndex], weight);
+  }
+
+
+  // ... and part curves.
+  bound += binding->ParameterCurveCount;
+  partOpacities = csmGetPartOpacities(model);
+
+
+  for (b = 0; b < binding->PartOpacityCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+
+
+    partOpacities[i] = blend(partOpacities[i], values[bound[b].CurveIndex], weight);
+  }
+}
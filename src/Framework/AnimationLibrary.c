@@ -0,0 +1,422 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <limits.h>
+#include <stddef.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Aligns a size to the arena granularity (so animations placed back to back stay aligned).
+///
+/// @param  size  Size to align (in bytes).
+///
+/// @return  Aligned size.
+static inline unsigned long long AlignArenaSize(const unsigned long long size)
+{
+  return (size + (sizeof(void*) - 1)) & ~(unsigned long long)(sizeof(void*) - 1);
+}
+
+
+/// Finds the entry of a resident animation.
+///
+/// @param  library  Library to search.
+/// @param  key      Key of animation.
+///
+/// @return  Entry if resident; '0' otherwise.
+static csmAnimationLibraryEntry* FindLibraryEntry(const csmAnimationLibrary* library, const int key)
+{
+  int e;
+
+
+  for (e = 0; e < library->EntryCount; ++e)
+  {
+    if (library->Entries[e].Size && library->Entries[e].Key == key)
+    {
+      return library->Entries + e;
+    }
+  }
+
+
+  return 0;
+}
+
+/// Gets the animation of an entry.
+///
+/// @param  library  Library containing entry.
+/// @param  entry    Entry to query.
+///
+/// @return  Animation.
+static inline const csmAnimation* GetLibraryEntryAnimation(const csmAnimationLibrary* library, const csmAnimationLibraryEntry* entry)
+{
+  return (const csmAnimation*)(library->Arena + entry->Offset);
+}
+
+
+/// Evicts the least recently used animation.
+///
+/// @param  library  Library to evict from.
+///
+/// @return  Index of freed entry; '-1' if library is empty.
+static int EvictLeastRecentlyUsedAnimation(csmAnimationLibrary* library)
+{
+  csmAnimationLibraryEntry* entries;
+  int e, lru, previous;
+
+
+  entries = library->Entries;
+  lru = -1;
+
+
+  for (e = 0; e < library->EntryCount; ++e)
+  {
+    if (entries[e].Size && (lru == -1 || entries[e].LastUse < entries[lru].LastUse))
+    {
+      lru = e;
+    }
+  }
+
+
+  if (lru == -1)
+  {
+    return -1;
+  }
+
+
+  // Unlink entry from arena order.
+  if (library->FirstEntryIndex == lru)
+  {
+    library->FirstEntryIndex = entries[lru].NextEntryIndex;
+  }
+  else
+  {
+    previous = library->FirstEntryIndex;
+
+
+    while (entries[previous].NextEntryIndex != lru)
+    {
+      previous = entries[previous].NextEntryIndex;
+    }
+
+
+    entries[previous].NextEntryIndex = entries[lru].NextEntryIndex;
+  }
+
+
+  // Make sure cached values don't outlive animation.
+  if (library->EvaluationCache)
+  {
+    csmDropCachedAnimationValues(library->EvaluationCache, GetLibraryEntryAnimation(library, entries + lru));
+  }
+
+
+  library->UsedSize -= entries[lru].Size;
+  library->EvictionCount += 1;
+
+
+  entries[lru].Size = 0;
+  entries[lru].NextEntryIndex = -1;
+
+
+  return lru;
+}
+
+/// Finds the first gap in the arena large enough for a size.
+///
+/// @param  library   Library to search.
+/// @param  size      Size to fit (in bytes).
+/// @param  offset    Offset of gap.
+/// @param  previous  Index of entry preceding gap ('-1' if gap is at start of arena).
+///
+/// @return  Non-zero if a gap was found; '0' otherwise.
+static int FindArenaGap(const csmAnimationLibrary* library, const unsigned int size, unsigned int* offset, int* previous)
+{
+  const csmAnimationLibraryEntry* entries;
+  unsigned int start;
+  int e;
+
+
+  entries = library->Entries;
+  start = 0;
+  *previous = -1;
+
+
+  // Walk resident animations in arena order.
+  for (e = library->FirstEntryIndex; e != -1; e = entries[e].NextEntryIndex)
+  {
+    if ((entries[e].Offset - start) >= size)
+    {
+      *offset = start;
+
+
+      return 1;
+    }
+
+
+    start = entries[e].Offset + entries[e].Size;
+    *previous = e;
+  }
+
+
+  *offset = start;
+
+
+  return (library->ArenaSize - start) >= size;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationLibrary(const int entryCount, const unsigned int arenaSize)
+{
+  unsigned long long size;
+
+
+  // Validate arguments.
+  Ensure((entryCount > 0), "\"entryCount\" is invalid.", return 0);
+
+
+  size = AlignArenaSize(sizeof(csmAnimationLibrary) + (sizeof(csmAnimationLibraryEntry) * (unsigned long long)entryCount))
+    + arenaSize;
+
+
+  Ensure((size <= UINT_MAX), "Animation library is too big.", return 0);
+
+
+  return (unsigned int)size;
+}
+
+csmAnimationLibrary* csmInitializeAnimationLibraryInPlace(const int entryCount,
+                                                          const unsigned int arenaSize,
+                                                          void* address,
+                                                          const unsigned int size)
+{
+  csmAnimationLibrary* library;
+  unsigned int requiredSize;
+  int e;
+
+
+  // Validate arguments.
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure(((size_t)address % sizeof(void*)) == 0, "\"address\" is misaligned.", return 0);
+
+
+  requiredSize = csmGetSizeofAnimationLibrary(entryCount, arenaSize);
+
+
+  Ensure((requiredSize && size >= requiredSize), "\"size\" is invalid.", return 0);
+
+
+  // Initialize fields.
+  library = (csmAnimationLibrary*)address;
+
+
+  library->EntryCount = entryCount;
+  library->FirstEntryIndex = -1;
+  library->ArenaSize = arenaSize;
+  library->UsedSize = 0;
+  library->HitCount = 0;
+  library->MissCount = 0;
+  library->EvictionCount = 0;
+  library->Clock = 0;
+  library->Entries = (csmAnimationLibraryEntry*)(library + 1);
+  library->Arena = (char*)library + (requiredSize - arenaSize);
+  library->EvaluationCache = 0;
+
+
+  for (e = 0; e < entryCount; ++e)
+  {
+    library->Entries[e].Key = 0;
+    library->Entries[e].Offset = 0;
+    library->Entries[e].Size = 0;
+    library->Entries[e].NextEntryIndex = -1;
+    library->Entries[e].LastUse = 0;
+  }
+
+
+  return library;
+}
+
+
+void csmSetAnimationLibraryEvaluationCache(csmAnimationLibrary* library, csmAnimationEvaluationCache* cache)
+{
+  // Validate argument.
+  Ensure(library, "\"library\" is invalid.", return);
+
+
+  library->EvaluationCache = cache;
+}
+
+
+const csmAnimation* csmFindLibraryAnimation(csmAnimationLibrary* library, const int key)
+{
+  csmAnimationLibraryEntry* entry;
+
+
+  // Validate argument.
+  Ensure(library, "\"library\" is invalid.", return 0);
+
+
+  entry = FindLibraryEntry(library, key);
+
+
+  if (!entry)
+  {
+    library->MissCount += 1;
+
+
+    return 0;
+  }
+
+
+  library->HitCount += 1;
+  library->Clock += 1;
+
+
+  entry->LastUse = library->Clock;
+
+
+  return GetLibraryEntryAnimation(library, entry);
+}
+
+const csmAnimation* csmLoadLibraryAnimation(csmAnimationLibrary* library,
+                                            const int key,
+                                            const char* motionJson,
+                                            const unsigned int length)
+{
+  csmAnimationLibraryEntry* entry;
+  unsigned long long alignedSize;
+  csmAnimation* animation;
+  unsigned int size, offset;
+  int e, previous;
+
+
+  // Validate arguments.
+  Ensure(library, "\"library\" is invalid.", return 0);
+  Ensure(motionJson, "\"motionJson\" is invalid.", return 0);
+
+
+  entry = FindLibraryEntry(library, key);
+
+
+  if (entry)
+  {
+    return GetLibraryEntryAnimation(library, entry);
+  }
+
+
+  size = csmGetDeserializedSizeofAnimationWithLength(motionJson, length);
+  alignedSize = AlignArenaSize(size);
+
+
+  Ensure((size && alignedSize <= library->ArenaSize), "\"motionJson\" exceeds memory budget of library.", return 0);
+
+
+  // Take a free entry...
+  e = 0;
+
+
+  while (e < library->EntryCount && library->Entries[e].Size)
+  {
+    ++e;
+  }
+
+
+  if (e == library->EntryCount)
+  {
+    e = EvictLeastRecentlyUsedAnimation(library);
+  }
+
+
+  // ... and evict until animation fits.
+  while (!FindArenaGap(library, (unsigned int)alignedSize, &offset, &previous))
+  {
+    EvictLeastRecentlyUsedAnimation(library);
+  }
+
+
+  // Place animation (only taking entry once animation is read).
+  animation = csmDeserializeAnimationInPlaceWithLength(motionJson, length, library->Arena + offset, size);
+
+
+  if (!animation)
+  {
+    return 0;
+  }
+
+
+  entry = library->Entries + e;
+
+
+  entry->Key = key;
+  entry->Offset = offset;
+  entry->Size = (unsigned int)alignedSize;
+
+
+  if (previous == -1)
+  {
+    entry->NextEntryIndex = library->FirstEntryIndex;
+    library->FirstEntryIndex = e;
+  }
+  else
+  {
+    entry->NextEntryIndex = library->Entries[previous].NextEntryIndex;
+    library->Entries[previous].NextEntryIndex = e;
+  }
+
+
+  library->UsedSize += entry->Size;
+  library->Clock += 1;
+
+
+  entry->LastUse = library->Clock;
+
+
+  return animation;
+}
+
+void csmGetAnimationLibraryStatistics(const csmAnimationLibrary* library, csmAnimationLibraryStatistics* statistics)
+{
+  int e;
+
+
+  // Validate arguments.
+  Ensure(library, "\"library\" is invalid.", return);
+  Ensure(statistics, "\"statistics\" is invalid.", return);
+
+
+  statistics->HitCount = library->HitCount;
+  statistics->MissCount = library->MissCount;
+  statistics->EvictionCount = library->EvictionCount;
+  statistics->AnimationCount = 0;
+  statistics->UsedSize = library->UsedSize;
+  statistics->ArenaSize = library->ArenaSize;
+
+
+  for (e = 0; e < library->EntryCount; ++e)
+  {
+    if (library->Entries[e].Size)
+    {
+      statistics->AnimationCount += 1;
+    }
+  }
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+#include <stddef.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Number of bits per mask word.
+static const int BitsPerWord = 64;
+
+
+/// Gets the number of words holding a bit per value.
+///
+/// @param  count  Number of values.
+///
+/// @return  Number of words.
+static inline int GetWordCount(const int count)
+{
+  return (count + (BitsPerWord - 1)) / BitsPerWord;
+}
+
+/// Checks whether a bit is set.
+///
+/// @param  bits   Bits to query.
+/// @param  count  Number of bits.
+/// @param  index  Index of bit (may be out of range).
+///
+/// @return  Non-zero if bit is in range and set; '0' otherwise.
+static inline int IsBitSet(const unsigned long long* bits, const int count, const int index)
+{
+  return index >= 0
+    && index < count
+    && ((bits[index / BitsPerWord] >> (index % BitsPerWord)) & 1ULL);
+}
+
+/// Sets or clears a bit.
+///
+/// @param  bits   Bits to update.
+/// @param  index  Index of bit.
+/// @param  isSet  Non-zero to set bit; '0' to clear it.
+static inline void SetBit(unsigned long long* bits, const int index, const int isSet)
+{
+  if (isSet)
+  {
+    bits[index / BitsPerWord] |= (1ULL << (index % BitsPerWord));
+  }
+  else
+  {
+    bits[index / BitsPerWord] &= ~(1ULL << (index % BitsPerWord));
+  }
+}
+
+
+/// Keeps bound curves whose targets are in a mask (compacting them to the front of a destination).
+///
+/// @param  bound        Bound curves to filter.
+/// @param  count        Number of bound curves.
+/// @param  bits         Mask bits indexed by target.
+/// @param  targetCount  Number of mask bits.
+/// @param  destination  Destination to write kept curves to (may alias 'bound' as long as it doesn't follow it).
+///
+/// @return  Number of kept curves.
+static int FilterCurveBindings(const csmAnimationCurveBinding* bound,
+                               const int count,
+                               const unsigned long long* bits,
+                               const int targetCount,
+                               csmAnimationCurveBinding* destination)
+{
+  int b, keptCount;
+
+
+  keptCount = 0;
+
+
+  for (b = 0; b < count; ++b)
+  {
+    if (!IsBitSet(bits, targetCount, bound[b].TargetIndex))
+    {
+      continue;
+    }
+
+
+    destination[keptCount] = bound[b];
+
+
+    ++keptCount;
+  }
+
+
+  return keptCount;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationMask(const csmModel* model)
+{
+  // Validate argument.
+  Ensure(model, "\"model\" is invalid.", return 0);
+
+
+  return (unsigned int)(sizeof(csmAnimationMask)
+    + (sizeof(unsigned long long) * (GetWordCount(csmGetParameterCount(model)) + GetWordCount(csmGetPartCount(model)))));
+}
+
+csmAnimationMask* csmInitializeAnimationMaskInPlace(const csmModel* model, void* address, const unsigned int size)
+{
+  csmAnimationMask* mask;
+  int w, wordCount;
+
+
+  // Validate arguments.
+  Ensure(model, "\"model\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure(((size_t)address % sizeof(unsigned long long)) == 0, "\"address\" is misaligned.", return 0);
+  Ensure((size >= csmGetSizeofAnimationMask(model)), "\"size\" is invalid.", return 0);
+
+
+  mask = (csmAnimationMask*)address;
+  mask->ParameterCount = csmGetParameterCount(model);
+  mask->PartCount = csmGetPartCount(model);
+  mask->ParameterBits = (unsigned long long*)(mask + 1);
+  mask->PartBits = mask->ParameterBits + GetWordCount(mask->ParameterCount);
+
+
+  // Start out empty.
+  wordCount = GetWordCount(mask->ParameterCount) + GetWordCount(mask->PartCount);
+
+
+  for (w = 0; w < wordCount; ++w)
+  {
+    mask->ParameterBits[w] = 0;
+  }
+
+
+  return mask;
+}
+
+
+void csmSetAnimationMaskParameter(csmAnimationMask* mask, const int parameterIndex, const int isIncluded)
+{
+  // Validate arguments.
+  Ensure(mask, "\"mask\" is invalid.", return);
+  Ensure((parameterIndex >= 0 && parameterIndex < mask->ParameterCount), "\"parameterIndex\" is invalid.", return);
+
+
+  SetBit(mask->ParameterBits, parameterIndex, isIncluded);
+}
+
+void csmSetAnimationMaskPart(csmAnimationMask* mask, const int partIndex, const int isIncluded)
+{
+  // Validate arguments.
+  Ensure(mask, "\"mask\" is invalid.", return);
+  Ensure((partIndex >= 0 && partIndex < mask->PartCount), "\"partIndex\" is invalid.", return);
+
+
+  SetBit(mask->PartBits, partIndex, isIncluded);
+}
+
+
+void csmMaskAnimationBinding(csmAnimationBinding* binding, const csmAnimationMask* mask)
+{
+  const csmAnimationCurveBinding* partOpacityCurves;
+  csmAnimationCurveBinding* bound;
+
+
+  // Validate arguments.
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure(mask, "\"mask\" is invalid.", return);
+
+
+  bound = binding->Curves + binding->ModelCurveCount;
+  partOpacityCurves = bound + binding->ParameterCurveCount;
+
+
+  // Filter parameter curves...
+  binding->ParameterCurveCount = FilterCurveBindings(bound, binding->ParameterCurveCount, mask->ParameterBits, mask->ParameterCount, bound);
+
+
+  // ... and part curves (moving them up behind kept parameter curves).
+  binding->PartOpacityCurveCount = FilterCurveBindings(partOpacityCurves,
+                                                       binding->PartOpacityCurveCount,
+                                                       mask->PartBits,
+                                                       mask->PartCount,
+                                                       bound + binding->ParameterCurveCount);
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Number of accumulators per target.
+static const int AccumulatorCount = 6;
+
+
+/// Accumulates bound curves of a layer.
+///
+/// @param  mixer           Mixer to accumulate into.
+/// @param  layer           Layer to evaluate.
+/// @param  bound           First bound curve to evaluate.
+/// @param  count           Number of bound curves to evaluate.
+/// @param  targetOffset    Offset of targets into accumulators.
+/// @param  time            Time to evaluate layer at.
+/// @param  segmentIndices  [Optional] Segment hints of layer.
+static void AccumulateLayerCurves(csmAnimationMixer* mixer,
+                                  const csmAnimationMixerLayer* layer,
+                                  const csmAnimationCurveBinding* bound,
+                                  const int count,
+                                  const int targetOffset,
+                                  const float time,
+                                  int* segmentIndices)
+{
+  float* values, * weights, * factors;
+  float value;
+  int b, i;
+
+
+  // Pick accumulators of blend mode.
+  switch (layer->BlendMode)
+  {
+    case csmAdditiveAnimationBlend:
+    {
+      values = mixer->AdditiveValues + targetOffset;
+      weights = 0;
+      factors = 0;
+
+
+      break;
+    }
+    case csmMultiplicativeAnimationBlend:
+    {
+      values = 0;
+      weights = 0;
+      factors = mixer->MultiplicativeFactors + targetOffset;
+
+
+      break;
+    }
+    case csmLerpAnimationBlend:
+    {
+      values = mixer->LerpValues + targetOffset;
+      weights = mixer->LerpWeights + targetOffset;
+      factors = 0;
+
+
+      break;
+    }
+    default:
+    {
+      values = mixer->OverrideValues + targetOffset;
+      weights = mixer->OverrideWeights + targetOffset;
+      factors = 0;
+
+
+      break;
+    }
+  }
+
+
+  for (b = 0; b < count; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateAnimationCurve(layer->Animation, bound[b].CurveIndex, time, (segmentIndices)
+      ? (segmentIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    if (factors)
+    {
+      factors[i] *= (1.0f - layer->Weight) + (value * layer->Weight);
+
+
+      continue;
+    }
+
+
+    values[i] += value * layer->Weight;
+
+
+    if (weights)
+    {
+      weights[i] += layer->Weight;
+    }
+  }
+}
+
+/// Writes accumulated values to targets.
+///
+/// @param  mixer         Mixer to read from.
+/// @param  targetOffset  Offset of targets into accumulators.
+/// @param  targets       Values to write to.
+/// @param  count         Number of targets.
+static void ApplyAccumulatedValues(const csmAnimationMixer* mixer, const int targetOffset, float* targets, const int count)
+{
+  const float* overrideValues, * overrideWeights, * lerpValues, * lerpWeights, * multiplicativeFactors, * additiveValues;
+  float base;
+  int i;
+
+
+  overrideValues = mixer->OverrideValues + targetOffset;
+  overrideWeights = mixer->OverrideWeights + targetOffset;
+  lerpValues = mixer->LerpValues + targetOffset;
+  lerpWeights = mixer->LerpWeights + targetOffset;
+  multiplicativeFactors = mixer->MultiplicativeFactors + targetOffset;
+  additiveValues = mixer->AdditiveValues + targetOffset;
+
+
+  for (i = 0; i < count; ++i)
+  {
+    // Keep untouched targets, and average overrides only if weights sum up to more than '1'.
+    base = (overrideWeights[i] > 0.0f)
+      ? (overrideValues[i] / ((overrideWeights[i] > 1.0f)
+        ? overrideWeights[i]
+        : 1.0f))
+      : targets[i];
+
+
+    // Lerp towards lerp layers (dropping current value once weights sum up to '1').
+    base = (lerpWeights[i] > 0.0f)
+      ? (((lerpWeights[i] < 1.0f)
+        ? ((base * (1.0f - lerpWeights[i])) + lerpValues[i])
+        : lerpValues[i]) / ((lerpWeights[i] > 1.0f)
+        ? lerpWeights[i]
+        : 1.0f))
+      : base;
+
+
+    targets[i] = (base * multiplicativeFactors[i]) + additiveValues[i];
+  }
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationMixer(const csmModel* model)
+{
+  // Validate argument.
+  Ensure(model, "\"model\" is invalid.", return 0);
+
+
+  return (unsigned int)(sizeof(csmAnimationMixer) + (sizeof(float) * AccumulatorCount * (csmGetParameterCount(model) + csmGetPartCount(model))));
+}
+
+csmAnimationMixer* csmInitializeAnimationMixerInPlace(const csmModel* model, void* address, const unsigned int size)
+{
+  csmAnimationMixer* mixer;
+  int targetCount;
+
+
+  // Validate arguments.
+  Ensure(model, "\"model\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((size >= csmGetSizeofAnimationMixer(model)), "\"size\" is invalid.", return 0);
+
+
+  mixer = (csmAnimationMixer*)address;
+  mixer->ParameterCount = csmGetParameterCount(model);
+  mixer->PartCount = csmGetPartCount(model);
+
+
+  targetCount = mixer->ParameterCount + mixer->PartCount;
+
+
+  mixer->OverrideValues = (float*)(mixer + 1);
+  mixer->OverrideWeights = mixer->OverrideValues + targetCount;
+  mixer->LerpValues = mixer->OverrideWeights + targetCount;
+  mixer->LerpWeights = mixer->LerpValues + targetCount;
+  mixer->MultiplicativeFactors = mixer->LerpWeights + targetCount;
+  mixer->AdditiveValues = mixer->MultiplicativeFactors + targetCount;
+
+
+  return mixer;
+}
+
+
+void csmEvaluateAnimationMixer(csmAnimationMixer* mixer,
+                               const csmAnimationMixerLayer* layers,
+                               const int layerCount,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  const csmAnimationMixerLayer* layer;
+  const csmAnimationBinding* binding;
+  int* segmentIndices;
+  float time;
+  int l, b, i, targetCount;
+
+
+  // Validate arguments.
+  Ensure(mixer, "\"mixer\" is invalid.", return);
+  Ensure((layers || layerCount == 0), "\"layers\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+  Ensure((mixer->ParameterCount == csmGetParameterCount(model) && mixer->PartCount == csmGetPartCount(model)),
+         "\"mixer\" doesn't match model.",
+         return);
+
+
+  for (l = 0; l < layerCount; ++l)
+  {
+    Ensure((layers[l].Animation && layers[l].Binding && layers[l].State), "\"layers\" are invalid.", return);
+    Ensure((!layers[l].Cursor || layers[l].Cursor->CurveCount == layers[l].Animation->CurveCount),
+           "\"cursor\" doesn't match animation.",
+           return);
+  }
+
+
+  // Reset accumulators.
+  targetCount = mixer->ParameterCount + mixer->PartCount;
+
+
+  for (i = 0; i < targetCount; ++i)
+  {
+    mixer->OverrideValues[i] = 0.0f;
+    mixer->OverrideWeights[i] = 0.0f;
+    mixer->LerpValues[i] = 0.0f;
+    mixer->LerpWeights[i] = 0.0f;
+    mixer->MultiplicativeFactors[i] = 1.0f;
+    mixer->AdditiveValues[i] = 0.0f;
+  }
+
+
+  // Accumulate layers.
+  for (l = 0; l < layerCount; ++l)
+  {
+    layer = layers + l;
+    binding = layer->Binding;
+    time = GetAnimationTime(layer->Animation, layer->State);
+
+
+    segmentIndices = (layer->Cursor)
+      ? layer->Cursor->SegmentIndices
+      : 0;
+
+
+    // Evaluate model curves.
+    bound = binding->Curves;
+
+
+    for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+    {
+      handleModelCurve(model,
+                       (csmModelAnimationCurveType)bound[b].TargetIndex,
+                       EvaluateAnimationCurve(layer->Animation, bound[b].CurveIndex, time, (segmentIndices)
+                         ? (segmentIndices + bound[b].CurveIndex)
+                         : 0),
+                       userData);
+    }
+
+
+    // Accumulate parameter and part curves.
+    bound += binding->ModelCurveCount;
+
+
+    AccumulateLayerCurves(mixer, layer, bound, binding->ParameterCurveCount, 0, time, segmentIndices);
+
+
+    bound += binding->ParameterCurveCount;
+
+
+    AccumulateLayerCurves(mixer, layer, bound, binding->PartOpacityCurveCount, mixer->ParameterCount, time, segmentIndices);
+  }
+
+
+  // Write each target once.
+  ApplyAccumulatedValues(mixer, 0, csmGetParameterValues(model), mixer->ParameterCount);
+  ApplyAccumulatedValues(mixer, mixer->ParameterCount, csmGetPartOpacities(model), mixer->PartCount);
+}
@@ -9,6 +9,13 @@
 #include <Live2DCubismFrameworkINTERNAL.h>
 
 
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+
 // ------- //
 // HELPERS //
 // ------- //
@@ -39,10 +46,7 @@ static inline csmAnimationPoint LerpPoints(const csmAnimationPoint a, const csmA
 
 float csmLinearAnimationSegmentEvaluationFunction(const csmAnimationPoint* points, const float time)
 {
-  float t = (time - points[0].Time) / (points[1].Time - points[0].Time);
-
-
-  return points[0].Value + ((points[1].Value - points[0].Value) * t);
+  return EvaluateLinearAnimationSegment(points, time);
 }
 
 //　Simple De Casteljau's algorithm implementation.
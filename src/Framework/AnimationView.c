@@ -0,0 +1,678 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Maximum number of curves evaluated in one batch.
+enum
+{
+  BatchSize = 64
+};
+
+
+/// Evaluates a linear segment of a view.
+///
+/// @param  view  View containing segment.
+/// @param  slot  Index of segment into linear segments.
+/// @param  time  Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateLinearSegment(const csmAnimationView* view, const int slot, const float time)
+{
+  return InterpolateLinearly(view->LinearSegments.StartTimes[slot],
+                             view->LinearSegments.Durations[slot],
+                             view->LinearSegments.StartValues[slot],
+                             view->LinearSegments.ValueDeltas[slot],
+                             time);
+}
+
+/// Evaluates a bezier segment of a view.
+///
+/// @param  view  View containing segment.
+/// @param  slot  Index of segment into bezier segments.
+/// @param  t     Curve parameter to evaluate at.
+///
+/// @return  Value at parameter.
+static inline float EvaluateBezierSegmentAt(const csmAnimationView* view, const int slot, const float t)
+{
+  return EvaluateCubicPolynomial(view->BezierSegments.Coefficients[0][slot],
+                                 view->BezierSegments.Coefficients[1][slot],
+                                 view->BezierSegments.Coefficients[2][slot],
+                                 view->BezierSegments.Coefficients[3][slot],
+                                 t);
+}
+
+/// Evaluates a bezier segment of a view.
+///
+/// @param  view  View containing segment.
+/// @param  slot  Index of segment into bezier segments.
+/// @param  time  Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateBezierSegment(const csmAnimationView* view, const int slot, const float time)
+{
+  return EvaluateBezierSegmentAt(view,
+                                 slot,
+                                 (time - view->BezierSegments.StartTimes[slot]) * view->BezierSegments.InverseDurations[slot]);
+}
+
+/// Evaluates an unrestricted bezier segment of a view.
+///
+/// @param  view  View containing segment.
+/// @param  slot  Index of segment into bezier segments.
+/// @param  time  Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateUnrestrictedBezierSegment(const csmAnimationView* view, const int slot, const float time)
+{
+  float t;
+
+
+  t = SolveBezierTimePolynomial(view->BezierSegments.TimeCoefficients[0][slot],
+                                view->BezierSegments.TimeCoefficients[1][slot],
+                                view->BezierSegments.TimeCoefficients[2][slot],
+                                (time - view->BezierSegments.StartTimes[slot]) * view->BezierSegments.InverseDurations[slot]);
+
+
+  return EvaluateBezierSegmentAt(view, slot, t);
+}
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+/// Gathers 4 values.
+///
+/// @param  values  Values to gather from.
+/// @param  slots   Indices of values to gather.
+///
+/// @return  Gathered values.
+static inline __m128 Gather4(const float* values, const int* slots)
+{
+  return _mm_set_ps(values[slots[3]], values[slots[2]], values[slots[1]], values[slots[0]]);
+}
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+/// Gathers 4 values.
+///
+/// @param  values  Values to gather from.
+/// @param  slots   Indices of values to gather.
+///
+/// @return  Gathered values.
+static inline float32x4_t Gather4(const float* values, const int* slots)
+{
+  float gathered[4];
+
+
+  gathered[0] = values[slots[0]];
+  gathered[1] = values[slots[1]];
+  gathered[2] = values[slots[2]];
+  gathered[3] = values[slots[3]];
+
+
+  return vld1q_f32(gathered);
+}
+#endif
+
+
+/// Evaluates linear segments of a view.
+///
+/// @param  view     View containing segments.
+/// @param  slots    Indices of segments into linear segments.
+/// @param  count    Number of segments to evaluate.
+/// @param  time     Time to evaluate at.
+/// @param  results  Buffer to write values to.
+static void EvaluateLinearSegments(const csmAnimationView* view, const int* slots, const int count, const float time, float* results)
+{
+  int s;
+
+
+  s = 0;
+
+
+#if _CSM_COMPONENTS_USE_AVX2
+  {
+    __m256i indices;
+    __m256 value;
+
+
+    for (; (s + 8) <= count; s += 8)
+    {
+      indices = _mm256_loadu_si256((const __m256i*)(slots + s));
+
+
+      value = InterpolateLinearly8(_mm256_i32gather_ps(view->LinearSegments.StartTimes, indices, 4),
+                                   _mm256_i32gather_ps(view->LinearSegments.Durations, indices, 4),
+                                   _mm256_i32gather_ps(view->LinearSegments.StartValues, indices, 4),
+                                   _mm256_i32gather_ps(view->LinearSegments.ValueDeltas, indices, 4),
+                                   _mm256_set1_ps(time));
+
+
+      _mm256_storeu_ps(results + s, value);
+    }
+  }
+#endif
+
+#if _CSM_COMPONENTS_USE_SSE2
+  {
+    __m128 value;
+
+
+    for (; (s + 4) <= count; s += 4)
+    {
+      value = InterpolateLinearly4(Gather4(view->LinearSegments.StartTimes, slots + s),
+                                   Gather4(view->LinearSegments.Durations, slots + s),
+                                   Gather4(view->LinearSegments.StartValues, slots + s),
+                                   Gather4(view->LinearSegments.ValueDeltas, slots + s),
+                                   _mm_set1_ps(time));
+
+
+      _mm_storeu_ps(results + s, value);
+    }
+  }
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+  {
+    float32x4_t value;
+
+
+    for (; (s + 4) <= count; s += 4)
+    {
+      value = InterpolateLinearly4(Gather4(view->LinearSegments.StartTimes, slots + s),
+                                   Gather4(view->LinearSegments.Durations, slots + s),
+                                   Gather4(view->LinearSegments.StartValues, slots + s),
+                                   Gather4(view->LinearSegments.ValueDeltas, slots + s),
+                                   vdupq_n_f32(time));
+
+
+      vst1q_f32(results + s, value);
+    }
+  }
+#endif
+
+
+  // Evaluate remaining segments one by one.
+  for (; s < count; ++s)
+  {
+    results[s] = EvaluateLinearSegment(view, slots[s], time);
+  }
+}
+
+/// Evaluates bezier segments of a view.
+///
+/// @param  view     View containing segments.
+/// @param  slots    Indices of segments into bezier segments.
+/// @param  count    Number of segments to evaluate.
+/// @param  time     Time to evaluate at.
+/// @param  results  Buffer to write values to.
+static void EvaluateBezierSegments(const csmAnimationView* view, const int* slots, const int count, const float time, float* results)
+{
+  int s;
+
+
+  // Solve unrestricted béziers one by one.
+  if (view->BezierSegments.TimeCoefficients[0])
+  {
+    for (s = 0; s < count; ++s)
+    {
+      results[s] = EvaluateUnrestrictedBezierSegment(view, slots[s], time);
+    }
+
+
+    return;
+  }
+
+
+  s = 0;
+
+
+#if _CSM_COMPONENTS_USE_AVX2
+  {
+    __m256i indices;
+    __m256 t, value;
+
+
+    for (; (s + 8) <= count; s += 8)
+    {
+      indices = _mm256_loadu_si256((const __m256i*)(slots + s));
+
+
+      t = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(time), _mm256_i32gather_ps(view->BezierSegments.StartTimes, indices, 4)),
+                        _mm256_i32gather_ps(view->BezierSegments.InverseDurations, indices, 4));
+
+
+      value = EvaluateCubicPolynomial8(_mm256_i32gather_ps(view->BezierSegments.Coefficients[0], indices, 4),
+                                       _mm256_i32gather_ps(view->BezierSegments.Coefficients[1], indices, 4),
+                                       _mm256_i32gather_ps(view->BezierSegments.Coefficients[2], indices, 4),
+                                       _mm256_i32gather_ps(view->BezierSegments.Coefficients[3], indices, 4),
+                                       t);
+
+
+      _mm256_storeu_ps(results + s, value);
+    }
+  }
+#endif
+
+#if _CSM_COMPONENTS_USE_SSE2
+  {
+    __m128 t, value;
+
+
+    for (; (s + 4) <= count; s += 4)
+    {
+      t = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(time), Gather4(view->BezierSegments.StartTimes, slots + s)),
+                     Gather4(view->BezierSegments.InverseDurations, slots + s));
+
+
+      value = EvaluateCubicPolynomial4(Gather4(view->BezierSegments.Coefficients[0], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[1], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[2], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[3], slots + s),
+                                       t);
+
+
+      _mm_storeu_ps(results + s, value);
+    }
+  }
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+  {
+    float32x4_t t, value;
+
+
+    for (; (s + 4) <= count; s += 4)
+    {
+      t = vmulq_f32(vsubq_f32(vdupq_n_f32(time), Gather4(view->BezierSegments.StartTimes, slots + s)),
+                    Gather4(view->BezierSegments.InverseDurations, slots + s));
+
+
+      value = EvaluateCubicPolynomial4(Gather4(view->BezierSegments.Coefficients[0], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[1], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[2], slots + s),
+                                       Gather4(view->BezierSegments.Coefficients[3], slots + s),
+                                       t);
+
+
+      vst1q_f32(results + s, value);
+    }
+  }
+#endif
+
+
+  // Evaluate remaining segments one by one.
+  for (; s < count; ++s)
+  {
+    results[s] = EvaluateBezierSegment(view, slots[s], time);
+  }
+}
+
+
+/// Counts segments of an animation per segment group.
+///
+/// @param  animation      Animation to query.
+/// @param  linearCount    Number of linear segments.
+/// @param  bezierCount    Number of bezier segments.
+/// @param  constantCount  Number of stepped and inverse stepped segments.
+static void CountSegments(const csmAnimation* animation, int* linearCount, int* bezierCount, int* constantCount)
+{
+  const csmAnimationSegment* segments;
+  int s;
+
+
+  segments = GetAnimationSegments(animation);
+
+
+  *linearCount = 0;
+  *bezierCount = 0;
+  *constantCount = 0;
+
+
+  for (s = 0; s < animation->TotalSegmentCount; ++s)
+  {
+    if (GetAnimationSegmentType(segments + s) == csmLinearAnimationSegment)
+    {
+      ++(*linearCount);
+    }
+    else if (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+    {
+      ++(*bezierCount);
+    }
+    else
+    {
+      ++(*constantCount);
+    }
+  }
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofAnimationView(const csmAnimation* animation)
+{
+  int linearCount, bezierCount, constantCount, bezierSize;
+
+
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return 0);
+
+
+  CountSegments(animation, &linearCount, &bezierCount, &constantCount);
+
+
+  // Unrestricted béziers need their time polynomials, too.
+  bezierSize = (GetAnimationBezierTimePolynomials(animation))
+    ? 9
+    : 6;
+
+
+  return (unsigned int)(sizeof(csmAnimationView)
+    + (sizeof(int) * animation->TotalSegmentCount)
+    + (sizeof(float) * ((4 * linearCount) + (bezierSize * bezierCount) + constantCount)));
+}
+
+csmAnimationView* csmInitializeAnimationViewInPlace(const csmAnimation* animation, void* address, const unsigned int size)
+{
+  const csmAnimationBezierTimePolynomial* timePolynomials;
+  const csmAnimationBezierPolynomial* polynomials;
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  csmAnimationView* view;
+  float* data;
+  int linearCount, bezierCount, constantCount, s, slot, type, p;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((size >= csmGetSizeofAnimationView(animation)), "\"size\" is invalid.", return 0);
+
+
+  CountSegments(animation, &linearCount, &bezierCount, &constantCount);
+
+
+  // Initialize pointer fields.
+  view = (csmAnimationView*)address;
+
+
+  view->SegmentSlots = (int*)(view + 1);
+  view->SegmentCount = animation->TotalSegmentCount;
+
+  data = (float*)(view->SegmentSlots + view->SegmentCount);
+
+
+  view->LinearSegments.StartTimes = data;
+  view->LinearSegments.Durations = view->LinearSegments.StartTimes + linearCount;
+  view->LinearSegments.StartValues = view->LinearSegments.Durations + linearCount;
+  view->LinearSegments.ValueDeltas = view->LinearSegments.StartValues + linearCount;
+  view->LinearSegments.Count = 0;
+
+  data = view->LinearSegments.ValueDeltas + linearCount;
+
+
+  view->BezierSegments.StartTimes = data;
+  view->BezierSegments.InverseDurations = view->BezierSegments.StartTimes + bezierCount;
+  view->BezierSegments.Coefficients[0] = view->BezierSegments.InverseDurations + bezierCount;
+  view->BezierSegments.Coefficients[1] = view->BezierSegments.Coefficients[0] + bezierCount;
+  view->BezierSegments.Coefficients[2] = view->BezierSegments.Coefficients[1] + bezierCount;
+  view->BezierSegments.Coefficients[3] = view->BezierSegments.Coefficients[2] + bezierCount;
+  view->BezierSegments.Count = 0;
+
+  data = view->BezierSegments.Coefficients[3] + bezierCount;
+
+
+  timePolynomials = GetAnimationBezierTimePolynomials(animation);
+
+
+  if (timePolynomials)
+  {
+    view->BezierSegments.TimeCoefficients[0] = data;
+    view->BezierSegments.TimeCoefficients[1] = view->BezierSegments.TimeCoefficients[0] + bezierCount;
+    view->BezierSegments.TimeCoefficients[2] = view->BezierSegments.TimeCoefficients[1] + bezierCount;
+
+    data = view->BezierSegments.TimeCoefficients[2] + bezierCount;
+  }
+  else
+  {
+    view->BezierSegments.TimeCoefficients[0] = 0;
+    view->BezierSegments.TimeCoefficients[1] = 0;
+    view->BezierSegments.TimeCoefficients[2] = 0;
+  }
+
+
+  view->ConstantSegments.Values = data;
+  view->ConstantSegments.Count = 0;
+
+
+  // Group segments.
+  segments = GetAnimationSegments(animation);
+  points = GetAnimationPoints(animation);
+  polynomials = GetAnimationBezierPolynomials(animation);
+
+
+  for (s = 0; s < view->SegmentCount; ++s)
+  {
+    type = GetAnimationSegmentType(segments + s);
+    p = GetAnimationSegmentBasePointIndex(segments + s);
+
+
+    if (type == csmLinearAnimationSegment)
+    {
+      slot = view->LinearSegments.Count++;
+
+
+      view->LinearSegments.StartTimes[slot] = points[p].Time;
+      view->LinearSegments.Durations[slot] = points[p + 1].Time - points[p].Time;
+      view->LinearSegments.StartValues[slot] = points[p].Value;
+      view->LinearSegments.ValueDeltas[slot] = points[p + 1].Value - points[p].Value;
+    }
+    else if (type == csmBezierAnimationSegment)
+    {
+      // Béziers are grouped in order of segments, so slots match polynomial indices.
+      slot = view->BezierSegments.Count++;
+
+
+      view->BezierSegments.StartTimes[slot] = polynomials[slot].StartTime;
+      view->BezierSegments.InverseDurations[slot] = polynomials[slot].InverseDuration;
+      view->BezierSegments.Coefficients[0][slot] = polynomials[slot].Coefficients[0];
+      view->BezierSegments.Coefficients[1][slot] = polynomials[slot].Coefficients[1];
+      view->BezierSegments.Coefficients[2][slot] = polynomials[slot].Coefficients[2];
+      view->BezierSegments.Coefficients[3][slot] = polynomials[slot].Coefficients[3];
+
+
+      if (timePolynomials)
+      {
+        view->BezierSegments.TimeCoefficients[0][slot] = timePolynomials[slot].Coefficients[0];
+        view->BezierSegments.TimeCoefficients[1][slot] = timePolynomials[slot].Coefficients[1];
+        view->BezierSegments.TimeCoefficients[2][slot] = timePolynomials[slot].Coefficients[2];
+      }
+    }
+    else
+    {
+      slot = view->ConstantSegments.Count++;
+
+
+      view->ConstantSegments.Values[slot] = (type == csmSteppedAnimationSegment)
+        ? points[p].Value
+        : points[p + 1].Value;
+    }
+
+
+    view->SegmentSlots[s] = slot;
+  }
+
+
+  return view;
+}
+
+
+void csmEvaluateAnimationView(const csmAnimation* animation,
+                              const csmAnimationView* view,
+                              const csmAnimationBinding* binding,
+                              csmAnimationCursor* cursor,
+                              const csmAnimationState* state,
+                              const csmFloatBlendFunction blend,
+                              const float weight,
+                              csmModel* model,
+                              csmModelAnimationCurveHandler handleModelCurve,
+                              void* userData)
+{
+  int linearSlots[BatchSize], bezierSlots[BatchSize], linearCurves[BatchSize], bezierCurves[BatchSize];
+  float values[BatchSize], linearValues[BatchSize], bezierValues[BatchSize];
+  const csmAnimationCurveBinding* bound;
+  const csmAnimationSegment* segments;
+  const csmAnimationCurve* curves;
+  const csmAnimationPoint* points;
+  float* parameterValues, * partOpacities;
+  int boundCount, first, count, linearCount, bezierCount, b, c, s, i;
+  float time;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(view, "\"view\" is invalid.", return);
+  Ensure((view->SegmentCount == animation->TotalSegmentCount), "\"view\" doesn't match animation.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure((!cursor || cursor->CurveCount == animation->CurveCount), "\"cursor\" doesn't match animation.", return);
+  Ensure(state, "\"state\" is invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  time = GetAnimationTime(animation, state);
+
+
+  curves = GetAnimationCurves(animation);
+  segments = GetAnimationSegments(animation);
+  points = GetAnimationPoints(animation);
+
+  parameterValues = csmGetParameterValues(model);
+  partOpacities = csmGetPartOpacities(model);
+
+
+  boundCount = binding->ModelCurveCount + binding->ParameterCurveCount + binding->PartOpacityCurveCount;
+
+
+  for (first = 0; first < boundCount; first += BatchSize)
+  {
+    bound = binding->Curves + first;
+    count = ((boundCount - first) < BatchSize)
+      ? (boundCount - first)
+      : BatchSize;
+
+
+    // Find segments to evaluate and group them...
+    linearCount = 0;
+    bezierCount = 0;
+
+
+    for (b = 0; b < count; ++b)
+    {
+      c = bound[b].CurveIndex;
+
+
+      // Take values of settled curves as is.
+      if (time >= curves[c].StaticTime)
+      {
+        values[b] = curves[c].StaticValue;
+
+
+        continue;
+      }
+
+
+      s = FindAnimationSegment(segments + curves[c].BaseSegmentIndex, curves[c].SegmentCount, points, time, (cursor)
+        ? cursor->SegmentIndices[c]
+        : 0);
+
+
+      if (cursor)
+      {
+        cursor->SegmentIndices[c] = s;
+      }
+
+
+      s += curves[c].BaseSegmentIndex;
+
+
+      if (GetAnimationSegmentType(segments + s) == csmLinearAnimationSegment)
+      {
+        linearSlots[linearCount] = view->SegmentSlots[s];
+        linearCurves[linearCount] = b;
+
+
+        ++linearCount;
+      }
+      else if (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+      {
+        bezierSlots[bezierCount] = view->SegmentSlots[s];
+        bezierCurves[bezierCount] = b;
+
+
+        ++bezierCount;
+      }
+      else
+      {
+        values[b] = view->ConstantSegments.Values[view->SegmentSlots[s]];
+      }
+    }
+
+
+    // ... evaluate groups...
+    EvaluateLinearSegments(view, linearSlots, linearCount, time, linearValues);
+    EvaluateBezierSegments(view, bezierSlots, bezierCount, time, bezierValues);
+
+
+    for (i = 0; i < linearCount; ++i)
+    {
+      values[linearCurves[i]] = linearValues[i];
+    }
+
+    for (i = 0; i < bezierCount; ++i)
+    {
+      values[bezierCurves[i]] = bezierValues[i];
+    }
+
+
+    // ... and apply values in binding order.
+    for (b = 0; b < count; ++b)
+    {
+      i = first + b;
+
+
+      if (i < binding->ModelCurveCount)
+      {
+        if (handleModelCurve)
+        {
+          handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, values[b], userData);
+        }
+      }
+      else if (i < (binding->ModelCurveCount + binding->ParameterCurveCount))
+      {
+        parameterValues[bound[b].TargetIndex] = blend(parameterValues[bound[b].TargetIndex], values[b], weight);
+      }
+      else
+      {
+        partOpacities[bound[b].TargetIndex] = blend(partOpacities[bound[b].TargetIndex], values[b], weight);
+      }
+    }
+  }
+}
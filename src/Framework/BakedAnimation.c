@@ -0,0 +1,445 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+#include <limits.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Largest quantized sample.
+static const float MaxQuantizedSample = 65535.0f;
+
+
+/// Gets value ranges of a baked animation.
+///
+/// @param  animation  Baked animation to query.
+///
+/// @return  Ranges if samples are quantized; '0' otherwise.
+static inline csmBakedAnimationCurveRange* GetBakedAnimationRanges(const csmBakedAnimation* animation)
+{
+  return (animation->RangesOffset)
+    ? (csmBakedAnimationCurveRange*)((const char*)animation + animation->RangesOffset)
+    : 0;
+}
+
+/// Gets samples of a baked animation.
+///
+/// @param  animation  Baked animation to query.
+///
+/// @return  Samples.
+static inline void* GetBakedAnimationSamples(const csmBakedAnimation* animation)
+{
+  return (void*)((const char*)animation + animation->SamplesOffset);
+}
+
+
+/// Picks sample rate to bake at.
+///
+/// @param  animation   Animation to bake.
+/// @param  sampleRate  Requested sample rate.
+///
+/// @return  Sample rate to use.
+static float GetBakingSampleRate(const csmAnimation* animation, const float sampleRate)
+{
+  return (sampleRate > 0.0f)
+    ? sampleRate
+    : animation->Fps;
+}
+
+/// Computes the number of samples per curve.
+///
+/// @param  duration    Duration in seconds.
+/// @param  sampleRate  Samples per second.
+///
+/// @return  Number of samples on success; '0' otherwise.
+static int GetSampleCount(const float duration, const float sampleRate)
+{
+  float count;
+  int sampleCount;
+
+
+  // Validate arguments (NaNs included).
+  if (!(sampleRate > 0.0f) || !(duration >= 0.0f))
+  {
+    return 0;
+  }
+
+
+  count = duration * sampleRate;
+
+
+  if (!(count < (float)(INT_MAX / 4)))
+  {
+    return 0;
+  }
+
+
+  // Round up and keep a sample at both ends.
+  sampleCount = (int)count;
+  sampleCount += ((float)sampleCount < count)
+    ? 2
+    : 1;
+
+
+  return (sampleCount < 2)
+    ? 2
+    : sampleCount;
+}
+
+/// Picks sample rate evenly spacing samples over duration (so the last sample falls on the end of the animation).
+///
+/// @param  duration     Duration in seconds.
+/// @param  sampleCount  Number of samples per curve.
+/// @param  sampleRate   Requested sample rate.
+///
+/// @return  Sample rate to store.
+static float GetEvenSampleRate(const float duration, const int sampleCount, const float sampleRate)
+{
+  return (duration > 0.0f)
+    ? ((float)(sampleCount - 1) / duration)
+    : sampleRate;
+}
+
+/// Gets the time of a sample.
+///
+/// @param  animation  Baked animation to query.
+/// @param  sample     Index of sample.
+///
+/// @return  Time of sample in seconds.
+static inline float GetBakedSampleTime(const csmBakedAnimation* animation, const int sample)
+{
+  return animation->Duration * ((float)sample / (float)(animation->SampleCount - 1));
+}
+
+
+/// Computes the size of a baked animation.
+///
+/// @param  curveCount   Number of curves.
+/// @param  sampleCount  Number of samples per curve.
+/// @param  quantize     Non-zero if samples are quantized.
+///
+/// @return  Number of bytes necessary.
+static unsigned long long GetSizeofBakedAnimation(const int curveCount, const int sampleCount, const int quantize)
+{
+  return sizeof(csmBakedAnimation) + ((quantize)
+    ? ((sizeof(csmBakedAnimationCurveRange) * (unsigned long long)curveCount)
+      + (sizeof(unsigned short) * (unsigned long long)curveCount * (unsigned long long)sampleCount))
+    : (sizeof(float) * (unsigned long long)curveCount * (unsigned long long)sampleCount));
+}
+
+
+/// 'Repeats' time of a baked animation as necessary.
+///
+/// @param  animation  Baked animation to evaluate.
+/// @param  state      Animation state.
+///
+/// @return  Time to evaluate animation at.
+static inline float GetBakedAnimationTime(const csmBakedAnimation* animation, const csmAnimationState* state)
+{
+  float time;
+
+
+  time = state->Time;
+
+
+  if (animation->Loop)
+  {
+    while (time > animation->Duration)
+    {
+      time -= animation->Duration;
+    }
+  }
+
+
+  return time;
+}
+
+
+/// Evaluates a baked curve.
+///
+/// @param  animation  Baked animation containing curve.
+/// @param  index      Curve index.
+/// @param  sample     Index of sample before time.
+/// @param  fraction   Position of time between sample and next sample.
+///
+/// @return  Value at time.
+static inline float EvaluateBakedCurve(const csmBakedAnimation* animation, const int index, const int sample, const float fraction)
+{
+  const csmBakedAnimationCurveRange* range;
+  const unsigned short* quantizedSamples;
+  const float* samples;
+  float a, b;
+
+
+  // Interpolate quantized samples before scaling them...
+  if (animation->RangesOffset)
+  {
+    range = GetBakedAnimationRanges(animation) + index;
+    quantizedSamples = (const unsigned short*)GetBakedAnimationSamples(animation) + (index * animation->SampleCount) + sample;
+
+
+    a = (float)quantizedSamples[0];
+    b = (float)quantizedSamples[1];
+
+
+    return range->Minimum + (range->Scale * (a + ((b - a) * fraction)));
+  }
+
+
+  // ... or interpolate samples right away.
+  samples = (const float*)GetBakedAnimationSamples(animation) + (index * animation->SampleCount) + sample;
+
+
+  return samples[0] + ((samples[1] - samples[0]) * fraction);
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+unsigned int csmGetSizeofBakedAnimation(const csmAnimation* animation, const float sampleRate, const int quantize)
+{
+  unsigned long long size;
+  int sampleCount;
+
+
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+
+
+  sampleCount = GetSampleCount(animation->Duration, GetBakingSampleRate(animation, sampleRate));
+
+
+  Ensure(sampleCount, "\"sampleRate\" is invalid.", return 0);
+
+
+  size = GetSizeofBakedAnimation(animation->CurveCount, sampleCount, quantize);
+
+
+  Ensure((size <= UINT_MAX), "Baked animation is too big.", return 0);
+
+
+  return (unsigned int)size;
+}
+
+csmBakedAnimation* csmBakeAnimationInPlace(const csmAnimation* animation,
+                                           const float sampleRate,
+                                           const int quantize,
+                                           void* address,
+                                           const unsigned int size)
+{
+  csmBakedAnimationCurveRange* ranges;
+  unsigned short* quantizedSamples;
+  csmBakedAnimation* baked;
+  float* samples;
+  float time, value, minimum, maximum;
+  unsigned int requiredSize;
+  int c, i, segmentIndex;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+
+
+  requiredSize = csmGetSizeofBakedAnimation(animation, sampleRate, quantize);
+
+
+  Ensure((requiredSize && size >= requiredSize), "\"size\" is invalid.", return 0);
+
+
+  // Initialize fields.
+  baked = (csmBakedAnimation*)address;
+
+
+  baked->Duration = animation->Duration;
+  baked->Loop = animation->Loop;
+  baked->CurveCount = animation->CurveCount;
+  baked->SampleCount = GetSampleCount(baked->Duration, GetBakingSampleRate(animation, sampleRate));
+  baked->SampleRate = GetEvenSampleRate(baked->Duration, baked->SampleCount, GetBakingSampleRate(animation, sampleRate));
+
+  baked->RangesOffset = (quantize)
+    ? (int)sizeof(csmBakedAnimation)
+    : 0;
+  baked->SamplesOffset = (int)sizeof(csmBakedAnimation) + ((quantize)
+    ? (int)(sizeof(csmBakedAnimationCurveRange) * baked->CurveCount)
+    : 0);
+
+
+  ranges = GetBakedAnimationRanges(baked);
+  samples = (float*)GetBakedAnimationSamples(baked);
+  quantizedSamples = (unsigned short*)GetBakedAnimationSamples(baked);
+
+
+  // Sample curves.
+  for (c = 0; c < baked->CurveCount; ++c)
+  {
+    segmentIndex = 0;
+    minimum = 0.0f;
+    maximum = 0.0f;
+
+
+    for (i = 0; i < baked->SampleCount; ++i)
+    {
+      time = GetBakedSampleTime(baked, i);
+
+
+      value = EvaluateAnimationCurve(animation, c, time, &segmentIndex);
+
+
+      if (!quantize)
+      {
+        samples[(c * baked->SampleCount) + i] = value;
+
+
+        continue;
+      }
+
+
+      // Track value range for quantizing.
+      minimum = (i == 0 || value < minimum)
+        ? value
+        : minimum;
+      maximum = (i == 0 || value > maximum)
+        ? value
+        : maximum;
+    }
+
+
+    if (!quantize)
+    {
+      continue;
+    }
+
+
+    // Quantize samples relative to value range.
+    ranges[c].Minimum = minimum;
+    ranges[c].Scale = (maximum - minimum) / MaxQuantizedSample;
+
+
+    segmentIndex = 0;
+
+
+    for (i = 0; i < baked->SampleCount; ++i)
+    {
+      time = GetBakedSampleTime(baked, i);
+
+
+      value = (ranges[c].Scale > 0.0f)
+        ? (((EvaluateAnimationCurve(animation, c, time, &segmentIndex) - minimum) / ranges[c].Scale) + 0.5f)
+        : 0.0f;
+
+
+      quantizedSamples[(c * baked->SampleCount) + i] = (unsigned short)((value < MaxQuantizedSample)
+        ? value
+        : MaxQuantizedSample);
+    }
+  }
+
+
+  return baked;
+}
+
+
+void csmEvaluateBakedAnimation(const csmBakedAnimation* animation,
+                               const csmAnimationBinding* binding,
+                               const csmAnimationState* state,
+                               const csmFloatBlendFunction blend,
+                               const float weight,
+                               csmModel* model,
+                               csmModelAnimationCurveHandler handleModelCurve,
+                               void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  float* parameterValues, * partOpacities;
+  float position, fraction, value;
+  int b, i, sample;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure(state, "\"state\" is invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  // Locate samples once for all curves (clamping to samples and handling NaNs, too).
+  position = GetBakedAnimationTime(animation, state) * animation->SampleRate;
+  position = (position > 0.0f)
+    ? position
+    : 0.0f;
+  position = (position < (float)(animation->SampleCount - 1))
+    ? position
+    : (float)(animation->SampleCount - 1);
+
+  sample = (int)position;
+  sample = (sample < (animation->SampleCount - 2))
+    ? sample
+    : (animation->SampleCount - 2);
+
+  fraction = position - (float)sample;
+
+
+  // Evaluate model curves.
+  bound = binding->Curves;
+
+
+  for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+  {
+    value = EvaluateBakedCurve(animation, bound[b].CurveIndex, sample, fraction);
+
+
+    handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, value, userData);
+  }
+
+
+  // Evaluate parameter curves (in order of parameters).
+  bound += binding->ModelCurveCount;
+  parameterValues = csmGetParameterValues(model);
+
+
+  for (b = 0; b < binding->ParameterCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateBakedCurve(animation, bound[b].CurveIndex, sample, fraction);
+
+
+    parameterValues[i] = blend(parameterValues[i], value, weight);
+  }
+
+
+  // Evaluate part curves (in order of parts).
+  bound += binding->ParameterCurveCount;
+  partOpacities = csmGetPartOpacities(model);
+
+
+  for (b = 0; b < binding->PartOpacityCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateBakedCurve(animation, bound[b].CurveIndex, sample, fraction);
+
+
+    partOpacities[i] = blend(partOpacities[i], value, weight);
+  }
+}
@@ -0,0 +1,1013 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <Live2DCubismCore.h>
+
+#include <limits.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Largest quantized time or value.
+static const float MaxQuantizedKey = 65535.0f;
+
+/// Maximum number of linear pieces to sample bezier segments into.
+static const int MaxBezierSubdivisionCount = 64;
+
+/// Share of tolerance to allow for sampling bezier segments into linear pieces.
+static const float BezierSubdivisionTolerance = 0.25f;
+
+/// Number of times per source segment to measure errors at.
+static const int ErrorSampleCount = 256;
+
+
+/// Gets curves of a compressed animation.
+///
+/// @param  animation  Compressed animation to query.
+///
+/// @return  Curves.
+static inline csmCompressedAnimationCurve* GetCompressedAnimationCurves(const csmCompressedAnimation* animation)
+{
+  return (csmCompressedAnimationCurve*)((const char*)animation + animation->CurvesOffset);
+}
+
+/// Gets keys of a compressed animation.
+///
+/// @param  animation  Compressed animation to query.
+///
+/// @return  Keys.
+static inline csmCompressedAnimationKey* GetCompressedAnimationKeys(const csmCompressedAnimation* animation)
+{
+  return (csmCompressedAnimationKey*)((const char*)animation + animation->KeysOffset);
+}
+
+
+/// Picks quantization step for key times.
+///
+/// @param  animation  Animation to compress.
+///
+/// @return  Seconds per step.
+static float GetCompressedTimeScale(const csmAnimation* animation)
+{
+  const csmAnimationSegment* segments;
+  const csmAnimationSegment* segment;
+  const csmAnimationCurve* curves;
+  const csmAnimationPoint* points;
+  float end, time;
+  int c;
+
+
+  curves = GetAnimationCurves(animation);
+  segments = GetAnimationSegments(animation);
+  end = animation->Duration;
+
+
+  // Cover curves ending after animation, too.
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].SegmentCount < 1)
+    {
+      continue;
+    }
+
+
+    segment = segments + curves[c].BaseSegmentIndex + curves[c].SegmentCount - 1;
+    points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(segment);
+    time = (GetAnimationSegmentType(segment) == csmBezierAnimationSegment)
+      ? points[3].Time
+      : points[1].Time;
+
+
+    end = (time > end)
+      ? time
+      : end;
+  }
+
+
+  return (end > 0.0f)
+    ? (end / MaxQuantizedKey)
+    : 1.0f;
+}
+
+/// Computes the size of a compressed animation.
+///
+/// @param  curveCount  Number of curves.
+/// @param  keyCount    Total number of keys.
+///
+/// @return  Number of bytes necessary.
+static unsigned long long GetSizeofCompressedAnimation(const int curveCount, const int keyCount)
+{
+  return sizeof(csmCompressedAnimation)
+    + (sizeof(csmCompressedAnimationCurve) * (unsigned long long)curveCount)
+    + (sizeof(csmCompressedAnimationKey) * (unsigned long long)keyCount);
+}
+
+
+/// Quantizes a float relative to a scale.
+///
+/// @param  value  Value to quantize.
+/// @param  scale  Value per quantization step.
+///
+/// @return  Quantized value.
+static inline unsigned short Quantize(const float value, const float scale)
+{
+  float quantized;
+
+
+  quantized = (scale > 0.0f)
+    ? ((value / scale) + 0.5f)
+    : 0.0f;
+
+
+  // Clamp (handling NaNs, too).
+  return (unsigned short)((quantized > 0.0f)
+    ? ((quantized < MaxQuantizedKey)
+      ? quantized
+      : MaxQuantizedKey)
+    : 0.0f);
+}
+
+
+/// Picks the number of linear pieces to sample a bezier segment into.
+///
+/// Pieces are halved until their quarter points are within tolerance
+/// (checking midpoints only misses symmetric S-shapes).
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+/// @param  segment    Segment index relative to first segment of curve.
+/// @param  tolerance  Maximum value difference at quarter points.
+///
+/// @return  Number of pieces.
+static int GetBezierSubdivisionCount(const csmAnimation* animation, const int index, const int segment, const float tolerance)
+{
+  const csmAnimationPoint* points;
+  const csmAnimationCurve* curve;
+  float start, duration, a, b, fraction, value, error;
+  int count, i, j, segmentIndex;
+
+
+  curve = GetAnimationCurves(animation) + index;
+  points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(GetAnimationSegments(animation) + curve->BaseSegmentIndex + segment);
+  start = points[0].Time;
+  duration = points[3].Time - points[0].Time;
+
+
+  for (count = 1; count < MaxBezierSubdivisionCount; count *= 2)
+  {
+    segmentIndex = segment;
+    error = 0.0f;
+
+
+    for (i = 0; i < count && error <= tolerance; ++i)
+    {
+      a = EvaluateAnimationCurve(animation, index, start + (duration * ((float)i / (float)count)), &segmentIndex);
+      b = EvaluateAnimationCurve(animation, index, start + (duration * (((float)i + 1.0f) / (float)count)), &segmentIndex);
+
+
+      for (j = 1; j < 4 && error <= tolerance; ++j)
+      {
+        fraction = (float)j * 0.25f;
+        value = EvaluateAnimationCurve(animation, index, start + (duration * (((float)i + fraction) / (float)count)), &segmentIndex);
+
+
+        error = value - (a + ((b - a) * fraction));
+        error = (error < 0.0f)
+          ? -error
+          : error;
+      }
+    }
+
+
+    if (error <= tolerance)
+    {
+      break;
+    }
+  }
+
+
+  return count;
+}
+
+
+/// Appends a candidate key.
+///
+/// @param  times   [Optional] Candidate times.
+/// @param  values  [Optional] Candidate values.
+/// @param  count   Number of candidates to append to.
+/// @param  time    Time of key.
+/// @param  value   Value of key.
+static inline void AppendCandidateKey(float* times, float* values, int* count, const float time, const float value)
+{
+  if (times)
+  {
+    times[*count] = time;
+    values[*count] = value;
+  }
+
+
+  ++(*count);
+}
+
+/// Samples a curve into linear candidate keys.
+///
+/// Steps are represented as two keys at the same time.
+/// Bezier segments are sampled at quantized times, so that quantizing keys doesn't move them.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+/// @param  tolerance  Maximum value difference for sampling bezier segments.
+/// @param  timeScale  Seconds per quantized time step.
+/// @param  times      [Optional] Buffer for candidate times.
+/// @param  values     [Optional] Buffer for candidate values.
+///
+/// @return  Number of candidate keys.
+static int SampleCandidateKeys(const csmAnimation* animation,
+                               const int index,
+                               const float tolerance,
+                               const float timeScale,
+                               float* times,
+                               float* values)
+{
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  const csmAnimationPoint* last;
+  const csmAnimationCurve* curve;
+  float time;
+  int count, s, i, pieceCount, segmentIndex;
+
+
+  curve = GetAnimationCurves(animation) + index;
+  segments = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  count = 0;
+
+
+  // Handle curves without segments.
+  if (curve->SegmentCount < 1)
+  {
+    AppendCandidateKey(times, values, &count, 0.0f, 0.0f);
+
+
+    return count;
+  }
+
+
+  // Start with the value the curve actually evaluates to (which is the end value for inverse stepped segments).
+  points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(segments);
+  segmentIndex = 0;
+
+
+  AppendCandidateKey(times, values, &count, points[0].Time, EvaluateAnimationCurve(animation, index, points[0].Time, &segmentIndex));
+
+
+  for (s = 0; s < curve->SegmentCount; ++s)
+  {
+    points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(segments + s);
+
+
+    switch (GetAnimationSegmentType(segments + s))
+    {
+      case csmBezierAnimationSegment:
+      {
+        last = points + 3;
+        pieceCount = GetBezierSubdivisionCount(animation, index, s, tolerance);
+        segmentIndex = s;
+
+
+        for (i = 1; i < pieceCount; ++i)
+        {
+          time = points[0].Time + ((last->Time - points[0].Time) * ((float)i / (float)pieceCount));
+          time = (float)Quantize(time, timeScale) * timeScale;
+
+
+          AppendCandidateKey(times, values, &count, time, EvaluateAnimationCurve(animation, index, time, &segmentIndex));
+        }
+
+
+        break;
+      }
+      case csmSteppedAnimationSegment:
+      {
+        last = points + 1;
+
+
+        // Hold start value up to end of segment (and beyond for last segment).
+        AppendCandidateKey(times, values, &count, last->Time, points[0].Value);
+
+
+        if (s == (curve->SegmentCount - 1))
+        {
+          return count;
+        }
+
+
+        break;
+      }
+      case csmInverseSteppedAnimationSegment:
+      {
+        last = points + 1;
+
+
+        // Jump to end value at start of segment.
+        AppendCandidateKey(times, values, &count, points[0].Time, last->Value);
+
+
+        break;
+      }
+      default:
+      {
+        last = points + 1;
+
+
+        break;
+      }
+    }
+
+
+    AppendCandidateKey(times, values, &count, last->Time, last->Value);
+  }
+
+
+  return count;
+}
+
+
+/// Reduces candidate keys to the ones that can't be interpolated from their neighbors within tolerance.
+///
+/// @param  times      Candidate times.
+/// @param  values     Candidate values (replaced by single value for flat curves).
+/// @param  count      Number of candidates.
+/// @param  tolerance  Maximum value difference to drop keys at.
+/// @param  stack      Buffer for '2 * count' range bounds.
+/// @param  keep       Buffer for 'count' keep flags.
+///
+/// @return  Number of keys kept.
+static int ReduceCandidateKeys(const float* times,
+                               float* values,
+                               const int count,
+                               float tolerance,
+                               int* stack,
+                               unsigned char* keep)
+{
+  float minimum, maximum, interpolated, error, worstError;
+  int i, first, last, worst, top, keptCount;
+
+
+  minimum = values[0];
+  maximum = values[0];
+
+
+  for (i = 1; i < count; ++i)
+  {
+    minimum = (values[i] < minimum)
+      ? values[i]
+      : minimum;
+    maximum = (values[i] > maximum)
+      ? values[i]
+      : maximum;
+  }
+
+
+  for (i = 0; i < count; ++i)
+  {
+    keep[i] = (i == 0 || i == (count - 1));
+  }
+
+
+  // Collapse flat curves into a single key in the middle of their range.
+  if ((maximum - minimum) <= (tolerance * 2.0f))
+  {
+    values[0] = (minimum + maximum) * 0.5f;
+    keep[count - 1] = (count == 1);
+
+
+    return 1;
+  }
+
+
+  // Leave room for quantization errors.
+  tolerance -= ((maximum - minimum) / MaxQuantizedKey) * 0.5f;
+  tolerance = (tolerance > 0.0f)
+    ? tolerance
+    : 0.0f;
+
+
+  // Split ranges at their worst key until all keys in between are within tolerance.
+  stack[0] = 0;
+  stack[1] = count - 1;
+  top = 2;
+
+
+  while (top)
+  {
+    last = stack[--top];
+    first = stack[--top];
+    worst = -1;
+    worstError = tolerance;
+
+
+    for (i = first + 1; i < last; ++i)
+    {
+      interpolated = (times[last] > times[first])
+        ? (values[first] + ((values[last] - values[first]) * ((times[i] - times[first]) / (times[last] - times[first]))))
+        : values[first];
+      error = values[i] - interpolated;
+      error = (error < 0.0f)
+        ? -error
+        : error;
+
+
+      if (error > worstError)
+      {
+        worst = i;
+        worstError = error;
+      }
+    }
+
+
+    if (worst < 0)
+    {
+      continue;
+    }
+
+
+    keep[worst] = 1;
+
+
+    stack[top++] = first;
+    stack[top++] = worst;
+    stack[top++] = worst;
+    stack[top++] = last;
+  }
+
+
+  keptCount = 0;
+
+
+  for (i = 0; i < count; ++i)
+  {
+    keptCount += keep[i];
+  }
+
+
+  return keptCount;
+}
+
+
+/// 'Repeats' time of a compressed animation as necessary.
+///
+/// @param  animation  Compressed animation to evaluate.
+/// @param  state      Animation state.
+///
+/// @return  Time to evaluate animation at.
+static inline float GetCompressedAnimationTime(const csmCompressedAnimation* animation, const csmAnimationState* state)
+{
+  float time;
+
+
+  time = state->Time;
+
+
+  if (animation->Loop)
+  {
+    while (time > animation->Duration)
+    {
+      time -= animation->Duration;
+    }
+  }
+
+
+  return time;
+}
+
+
+/// Finds the key range to evaluate.
+///
+/// @param  keys      Keys of curve.
+/// @param  keyCount  Number of keys of curve (at least '2').
+/// @param  position  Time in quantized steps.
+/// @param  hint      Index of key to check first.
+///
+/// @return  Index of last key at or before position (but at most the key before the last key).
+static inline int FindCompressedAnimationKey(const csmCompressedAnimationKey* keys,
+                                             const int keyCount,
+                                             const float position,
+                                             const int hint)
+{
+  int first, last, middle, k;
+
+
+  // Check hinted key and next one.
+  for (k = hint; k <= (hint + 1) && k >= 0 && k < (keyCount - 1); ++k)
+  {
+    if (k > 0 && (float)keys[k].Time > position)
+    {
+      break;
+    }
+
+
+    if (k == (keyCount - 2) || (float)keys[k + 1].Time > position)
+    {
+      return k;
+    }
+  }
+
+
+  // Search last key at or before position.
+  first = 0;
+  last = keyCount - 2;
+
+
+  while (first < last)
+  {
+    middle = first + ((last - first + 1) / 2);
+
+
+    if ((float)keys[middle].Time > position)
+    {
+      last = middle - 1;
+    }
+    else
+    {
+      first = middle;
+    }
+  }
+
+
+  return first;
+}
+
+/// Evaluates a compressed curve.
+///
+/// @param  animation  Compressed animation containing curve.
+/// @param  index      Curve index.
+/// @param  position   Time in quantized steps.
+/// @param  keyIndex   [Optional] Index of key to check first; updated to the key evaluated.
+///
+/// @return  Value at time.
+static inline float EvaluateCompressedCurve(const csmCompressedAnimation* animation,
+                                            const int index,
+                                            const float position,
+                                            int* keyIndex)
+{
+  const csmCompressedAnimationCurve* curve;
+  const csmCompressedAnimationKey* keys;
+  float a, b, fraction;
+  int k;
+
+
+  curve = GetCompressedAnimationCurves(animation) + index;
+  keys = GetCompressedAnimationKeys(animation) + curve->BaseKeyIndex;
+
+
+  // Return constant curves right away.
+  if (curve->KeyCount < 2)
+  {
+    return curve->MinimumValue + (curve->ValueScale * (float)keys[0].Value);
+  }
+
+
+  k = FindCompressedAnimationKey(keys, curve->KeyCount, position, (keyIndex)
+    ? *keyIndex
+    : 0);
+
+
+  if (keyIndex)
+  {
+    *keyIndex = k;
+  }
+
+
+  // Interpolate (taking the later key of steps).
+  a = (float)keys[k].Time;
+  b = (float)keys[k + 1].Time;
+
+  fraction = (b > a)
+    ? ((position - a) / (b - a))
+    : 1.0f;
+  fraction = (fraction > 0.0f)
+    ? ((fraction < 1.0f)
+      ? fraction
+      : 1.0f)
+    : 0.0f;
+
+
+  a = (float)keys[k].Value;
+  b = (float)keys[k + 1].Value;
+
+
+  return curve->MinimumValue + (curve->ValueScale * (a + ((b - a) * fraction)));
+}
+
+
+/// Measures the maximum difference between a source curve and its compressed counterpart.
+///
+/// Errors are measured at evenly spaced times within each source segment.
+/// Times within a quantization step of segment bounds are left out, as steps may move by that much.
+///
+/// @param  animation   Source animation.
+/// @param  compressed  Compressed animation.
+/// @param  index       Curve index.
+///
+/// @return  Maximum error.
+static float MeasureCompressedCurveError(const csmAnimation* animation, const csmCompressedAnimation* compressed, const int index)
+{
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  const csmAnimationCurve* curve;
+  float time, start, end, error, maxError;
+  int s, i, segmentIndex, keyIndex;
+
+
+  curve = GetAnimationCurves(animation) + index;
+  segments = GetAnimationSegments(animation) + curve->BaseSegmentIndex;
+  maxError = 0.0f;
+  segmentIndex = 0;
+  keyIndex = 0;
+
+
+  for (s = 0; s < curve->SegmentCount; ++s)
+  {
+    points = GetAnimationPoints(animation) + GetAnimationSegmentBasePointIndex(segments + s);
+    start = points[0].Time + compressed->TimeScale;
+    end = ((GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+      ? points[3].Time
+      : points[1].Time) - compressed->TimeScale;
+
+
+    for (i = 0; i < ErrorSampleCount && end > start; ++i)
+    {
+      time = start + ((end - start) * (((float)i + 0.5f) / (float)ErrorSampleCount));
+
+
+      error = EvaluateAnimationCurve(animation, index, time, &segmentIndex)
+        - EvaluateCompressedCurve(compressed, index, time / compressed->TimeScale, &keyIndex);
+      error = (error < 0.0f)
+        ? -error
+        : error;
+
+
+      // Keep NaNs from hiding errors.
+      maxError = (error > maxError || error != error)
+        ? error
+        : maxError;
+    }
+  }
+
+
+  return maxError;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+csmCompressedAnimation* csmCompressAnimation(const csmAnimation* animation,
+                                             const float tolerance,
+                                             csmAllocateFunction allocate,
+                                             csmDeallocateFunction deallocate)
+{
+  csmCompressedAnimationCurve* curves;
+  csmCompressedAnimationKey* keys;
+  csmCompressedAnimation* compressed;
+  unsigned long long size;
+  unsigned char* keep;
+  float* times, * values;
+  float minimum, maximum, subdivisionTolerance, timeScale;
+  int* stack;
+  void* scratch;
+  int c, i, count, maxCount, keyCount, totalKeyCount;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(!animation->LazySourceOffset, "\"animation\" has curves left to decode.", return 0);
+  Ensure((tolerance >= 0.0f), "\"tolerance\" is invalid.", return 0);
+  Ensure(allocate, "\"allocate\" is invalid.", return 0);
+  Ensure(deallocate, "\"deallocate\" is invalid.", return 0);
+
+
+  // Allocate temporary memory for largest curve.
+  subdivisionTolerance = tolerance * BezierSubdivisionTolerance;
+  timeScale = GetCompressedTimeScale(animation);
+  maxCount = 1;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    count = SampleCandidateKeys(animation, c, subdivisionTolerance, timeScale, 0, 0);
+    maxCount = (count > maxCount)
+      ? count
+      : maxCount;
+  }
+
+
+  scratch = allocate((unsigned int)((sizeof(float) * 2 + sizeof(int) * 2 + sizeof(unsigned char)) * maxCount));
+
+
+  if (!scratch)
+  {
+    Log("[Live2D Cubism Components] Failed to allocate temporary memory for compressing animation.");
+
+
+    return 0;
+  }
+
+
+  times = (float*)scratch;
+  values = times + maxCount;
+  stack = (int*)(values + maxCount);
+  keep = (unsigned char*)(stack + (maxCount * 2));
+
+
+  // Reduce curves once for sizing...
+  totalKeyCount = 0;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    count = SampleCandidateKeys(animation, c, subdivisionTolerance, timeScale, times, values);
+    totalKeyCount += ReduceCandidateKeys(times, values, count, tolerance - subdivisionTolerance, stack, keep);
+  }
+
+
+  size = GetSizeofCompressedAnimation(animation->CurveCount, totalKeyCount);
+  compressed = (size <= UINT_MAX)
+    ? (csmCompressedAnimation*)allocate((unsigned int)size)
+    : 0;
+
+
+  if (!compressed)
+  {
+    Log("[Live2D Cubism Components] Failed to allocate compressed animation.");
+    deallocate(scratch);
+
+
+    return 0;
+  }
+
+
+  // Initialize fields.
+  compressed->Duration = animation->Duration;
+  compressed->TimeScale = timeScale;
+  compressed->Loop = animation->Loop;
+  compressed->CurveCount = animation->CurveCount;
+  compressed->TotalKeyCount = totalKeyCount;
+  compressed->SourceSize = csmGetSerializedSizeofAnimation(animation) - (unsigned int)sizeof(csmAnimationBlobHeader);
+
+  compressed->CurvesOffset = (int)sizeof(csmCompressedAnimation);
+  compressed->KeysOffset = compressed->CurvesOffset + (int)(sizeof(csmCompressedAnimationCurve) * compressed->CurveCount);
+
+
+  curves = GetCompressedAnimationCurves(compressed);
+  keys = GetCompressedAnimationKeys(compressed);
+
+
+  // ... and once more for writing keys.
+  totalKeyCount = 0;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    count = SampleCandidateKeys(animation, c, subdivisionTolerance, timeScale, times, values);
+    keyCount = ReduceCandidateKeys(times, values, count, tolerance - subdivisionTolerance, stack, keep);
+
+
+    // Quantize values relative to range of kept keys.
+    minimum = values[0];
+    maximum = values[0];
+
+
+    for (i = 1; i < count && keyCount > 1; ++i)
+    {
+      if (!keep[i])
+      {
+        continue;
+      }
+
+
+      minimum = (values[i] < minimum)
+        ? values[i]
+        : minimum;
+      maximum = (values[i] > maximum)
+        ? values[i]
+        : maximum;
+    }
+
+
+    curves[c].BaseKeyIndex = totalKeyCount;
+    curves[c].KeyCount = keyCount;
+    curves[c].MinimumValue = minimum;
+    curves[c].ValueScale = (maximum - minimum) / MaxQuantizedKey;
+
+
+    for (i = 0; i < count && keyCount; ++i)
+    {
+      if (!keep[i])
+      {
+        continue;
+      }
+
+
+      keys[totalKeyCount].Time = Quantize(times[i], compressed->TimeScale);
+      keys[totalKeyCount].Value = Quantize(values[i] - minimum, curves[c].ValueScale);
+
+
+      ++totalKeyCount;
+      --keyCount;
+    }
+  }
+
+
+  deallocate(scratch);
+
+
+  // Measure errors against source.
+  for (c = 0; c < compressed->CurveCount; ++c)
+  {
+    curves[c].MaxError = MeasureCompressedCurveError(animation, compressed, c);
+  }
+
+
+  return compressed;
+}
+
+
+void csmGetAnimationCompressionReport(const csmCompressedAnimation* animation,
+                                      csmAnimationCompressionReport* report,
+                                      float* curveErrors)
+{
+  const csmCompressedAnimationCurve* curves;
+  int c;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(report, "\"report\" is invalid.", return);
+
+
+  curves = GetCompressedAnimationCurves(animation);
+
+
+  report->SourceSize = animation->SourceSize;
+  report->CompressedSize = (unsigned int)GetSizeofCompressedAnimation(animation->CurveCount, animation->TotalKeyCount);
+  report->Ratio = (float)report->SourceSize / (float)report->CompressedSize;
+  report->MaxError = 0.0f;
+  report->TimeResolution = animation->TimeScale;
+  report->CurveCount = animation->CurveCount;
+
+
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    report->MaxError = (curves[c].MaxError > report->MaxError || curves[c].MaxError != curves[c].MaxError)
+      ? curves[c].MaxError
+      : report->MaxError;
+
+
+    if (curveErrors)
+    {
+      curveErrors[c] = curves[c].MaxError;
+    }
+  }
+}
+
+
+unsigned int csmGetSizeofCompressedAnimationCursor(const csmCompressedAnimation* animation)
+{
+  // Validate argument.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+
+
+  return (unsigned int)(sizeof(csmCompressedAnimationCursor) + (sizeof(int) * animation->CurveCount));
+}
+
+csmCompressedAnimationCursor* csmInitializeCompressedAnimationCursorInPlace(const csmCompressedAnimation* animation,
+                                                                            void* address,
+                                                                            const unsigned int size)
+{
+  csmCompressedAnimationCursor* cursor;
+  int c;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+  Ensure((size >= csmGetSizeofCompressedAnimationCursor(animation)), "\"size\" is invalid.", return 0);
+
+
+  cursor = (csmCompressedAnimationCursor*)address;
+  cursor->CurveCount = animation->CurveCount;
+  cursor->KeyIndices = (int*)(cursor + 1);
+
+
+  for (c = 0; c < cursor->CurveCount; ++c)
+  {
+    cursor->KeyIndices[c] = 0;
+  }
+
+
+  return cursor;
+}
+
+
+void csmEvaluateCompressedAnimation(const csmCompressedAnimation* animation,
+                                    const csmAnimationBinding* binding,
+                                    csmCompressedAnimationCursor* cursor,
+                                    const csmAnimationState* state,
+                                    const csmFloatBlendFunction blend,
+                                    const float weight,
+                                    csmModel* model,
+                                    csmModelAnimationCurveHandler handleModelCurve,
+                                    void* userData)
+{
+  const csmAnimationCurveBinding* bound;
+  float* parameterValues, * partOpacities;
+  int* keyIndices;
+  float position, value;
+  int b, i;
+
+
+  // Validate arguments.
+  Ensure(animation, "\"animation\" is invalid.", return);
+  Ensure(binding, "\"binding\" is invalid.", return);
+  Ensure((!cursor || cursor->CurveCount == animation->CurveCount), "\"cursor\" doesn't match animation.", return);
+  Ensure(state, "\"state\" is invalid.", return);
+  Ensure(blend, "\"blend\" are invalid.", return);
+  Ensure(model, "\"model\" is invalid.", return);
+
+
+  // Convert time to quantized steps once for all curves.
+  position = GetCompressedAnimationTime(animation, state) / animation->TimeScale;
+
+
+  keyIndices = (cursor)
+    ? cursor->KeyIndices
+    : 0;
+
+
+  // Evaluate model curves.
+  bound = binding->Curves;
+
+
+  for (b = 0; handleModelCurve && b < binding->ModelCurveCount; ++b)
+  {
+    value = EvaluateCompressedCurve(animation, bound[b].CurveIndex, position, (keyIndices)
+      ? (keyIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    handleModelCurve(model, (csmModelAnimationCurveType)bound[b].TargetIndex, value, userData);
+  }
+
+
+  // Evaluate parameter curves (in order of parameters).
+  bound += binding->ModelCurveCount;
+  parameterValues = csmGetParameterValues(model);
+
+
+  for (b = 0; b < binding->ParameterCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateCompressedCurve(animation, bound[b].CurveIndex, position, (keyIndices)
+      ? (keyIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    parameterValues[i] = blend(parameterValues[i], value, weight);
+  }
+
+
+  // Evaluate part curves (in order of parts).
+  bound += binding->ParameterCurveCount;
+  partOpacities = csmGetPartOpacities(model);
+
+
+  for (b = 0; b < binding->PartOpacityCurveCount; ++b)
+  {
+    i = bound[b].TargetIndex;
+    value = EvaluateCompressedCurve(animation, bound[b].CurveIndex, position, (keyIndices)
+      ? (keyIndices + bound[b].CurveIndex)
+      : 0);
+
+
+    partOpacities[i] = blend(partOpacities[i], value, weight);
+  }
+}
@@ -22,3 +22,13 @@ float csmAdditiveFloatBlendFunction(float base, float value, float weight)
 {
   return base + (value * weight);
 }
+
+float csmMultiplicativeFloatBlendFunction(float base, float value, float weight)
+{
+  return base * ((1.0f - weight) + (value * weight));
+}
+
+float csmLerpFloatBlendFunction(float base, float value, float weight)
+{
+  return (base * (1.0f - weight)) + (value * weight);
+}
@@ -6,9 +6,20 @@
  */
 
 
+#include <Live2DCubismFramework.h>
 #include <Live2DCubismFrameworkINTERNAL.h>
 
 
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include "Local.h"
+
+#include <limits.h>
+#include <string.h>
+
+
 // ------- //
 // HELPERS //
 // ------- //
@@ -23,36 +34,296 @@ static const char False[] = "false";
 static const char Null[] = "null";
 
 
-/// Value identifying invalid token.
-static const csmJsonTokenType InvalidToken = csmJsonTokenTypeCount;
+/// Flags chars the lexer has to stop at (i.e. chars that start a token).
+static const unsigned char IsStructuralChar[256] =
+{
+  ['{'] = 1, ['}'] = 1, ['['] = 1, [']'] = 1, ['"'] = 1,
+  ['t'] = 1, ['f'] = 1, ['n'] = 1, ['-'] = 1,
+  ['0'] = 1, ['1'] = 1, ['2'] = 1, ['3'] = 1, ['4'] = 1,
+  ['5'] = 1, ['6'] = 1, ['7'] = 1, ['8'] = 1, ['9'] = 1
+};
+
+
+/// Checks whether a char continues a number token.
+///
+/// @param  c  Char to check.
+///
+/// @return  Non-zero if char is part of a number; '0' otherwise.
+static inline int IsNumberChar(const char c)
+{
+  return (c >= '0' && c <= '9') || c == '-' || c == '.' || c == 'e' || c == 'E' || c == '+';
+}
+
+
+/// Checks whether a char is JSON whitespace.
+///
+/// @param  c  Char to check.
+///
+/// @return  Non-zero if char is whitespace; '0' otherwise.
+static inline int IsWhitespaceChar(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+
+#if _CSM_COMPONENTS_USE_AVX2
+/// Classifies 32 chars at once.
+///
+/// @param  block  Chars to classify.
+///
+/// @return  Bit mask with bits set for structural chars.
+static inline unsigned int ClassifyChars32(const char* block)
+{
+  __m256i chars, digits, mask;
+
+
+  chars = _mm256_loadu_si256((const __m256i*)block);
+
+
+  // Flag digits by range checking...
+  digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  digits = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+
+
+  // ... and all other structural chars by comparing.
+  mask = _mm256_or_si256(digits, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('{')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('}')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('[')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(']')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('t')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('f')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('n')));
+  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('-')));
+
+
+  return (unsigned int)_mm256_movemask_epi8(mask);
+}
+#endif
+
+
+#if _CSM_COMPONENTS_USE_SSE2
+/// Classifies 16 chars at once.
+///
+/// @param  block  Chars to classify.
+///
+/// @return  Bit mask with bits set for structural chars.
+static inline unsigned int ClassifyChars16(const char* block)
+{
+  __m128i chars, digits, mask;
+
+
+  chars = _mm_loadu_si128((const __m128i*)block);
+
+
+  // Flag digits by range checking...
+  digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  digits = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+
+
+  // ... and all other structural chars by comparing.
+  mask = _mm_or_si128(digits, _mm_cmpeq_epi8(chars, _mm_set1_epi8('{')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('}')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('[')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8(']')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('"')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('t')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('f')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('n')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('-')));
+
+
+  return (unsigned int)_mm_movemask_epi8(mask);
+}
+#elif _CSM_COMPONENTS_USE_NEON
+/// Classifies 16 chars at once.
+///
+/// @param  block  Chars to classify.
+///
+/// @return  Mask with 4 bits set for each structural char.
+static inline unsigned long long ClassifyChars16(const char* block)
+{
+  uint8x16_t chars, mask;
+
+
+  chars = vld1q_u8((const uint8_t*)block);
+
+
+  // Flag digits by range checking...
+  mask = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(9));
+
+
+  // ... and all other structural chars by comparing.
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('{')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('}')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('[')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8(']')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('"')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('t')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('f')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('n')));
+  mask = vorrq_u8(mask, vceqq_u8(chars, vdupq_n_u8('-')));
+
+
+  // Narrow mask to 4 bits per char (as NEON lacks a 'movemask').
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+}
+#endif
+
+
+/// Finds next structural char.
+///
+/// @param  string    String to scan.
+/// @param  position  Offset to start scanning at (in chars).
+/// @param  length    Length of string (in chars).
+///
+/// @return  Offset of next structural char on success; 'length' otherwise.
+static inline int FindStructuralChar(const char* string, int position, const int length)
+{
+#if _CSM_COMPONENTS_USE_AVX2
+  unsigned int mask32;
+#endif
+#if _CSM_COMPONENTS_USE_SSE2
+  unsigned int mask;
+#elif _CSM_COMPONENTS_USE_NEON
+  unsigned long long mask;
+#endif
+
+
+  // Scan blocks...
+#if _CSM_COMPONENTS_USE_AVX2
+  for (; (position + 32) <= length; position += 32)
+  {
+    mask32 = ClassifyChars32(string + position);
+
+
+    if (mask32)
+    {
+      return position + FindLowestSetBit(mask32);
+    }
+  }
+#endif
+#if _CSM_COMPONENTS_USE_SSE2
+  for (; (position + 16) <= length; position += 16)
+  {
+    mask = ClassifyChars16(string + position);
+
+
+    if (mask)
+    {
+      return position + FindLowestSetBit(mask);
+    }
+  }
+#elif _CSM_COMPONENTS_USE_NEON
+  for (; (position + 16) <= length; position += 16)
+  {
+    mask = ClassifyChars16(string + position);
+
+
+    if (mask)
+    {
+      return position + (FindLowestSetBit(mask) >> 2);
+    }
+  }
+#endif
+
+
+  // ... and remaining chars.
+  for (; position < length; ++position)
+  {
+    if (IsStructuralChar[(unsigned char)string[position]])
+    {
+      return position;
+    }
+  }
+
+
+  return length;
+}
+
+
+/// Context for recording tokens into a tape.
+typedef struct TapeRecorderContext
+{
+  /// Tape to write to.
+  csmJsonToken* Tape;
+
+  /// Maximum number of tokens to write.
+  int Capacity;
+
+  /// Number of tokens recorded.
+  int TokenCount;
+}
+TapeRecorderContext;
+
+
+/// Records a token into a tape.
+///
+/// @param  jsonString            [Unused] JSON string.
+/// @param  type                  Token type.
+/// @param  begin                 Begin of token (in chars).
+/// @param  end                   End of token (in chars).
+/// @param  tapeRecorderContext   Recorder context.
+///
+/// @return  Always returns non-zero to keep lexing.
+static int RecordToken(const char* jsonString, const csmJsonTokenType type, const int begin, const int end, void* tapeRecorderContext)
+{
+  TapeRecorderContext* context;
+
+
+  (void)jsonString;
+
+
+  // Recover context.
+  context = tapeRecorderContext;
+
+
+  // Write token if there's room left (but keep counting in any case).
+  if (context->TokenCount < context->Capacity)
+  {
+    context->Tape[context->TokenCount].Type = type;
+    context->Tape[context->TokenCount].Begin = begin;
+    context->Tape[context->TokenCount].End = end;
+  }
+
+
+  context->TokenCount += 1;
+
+
+  return 1;
+}
 
 
 // -------------- //
 // IMPLEMENTATION //
 // -------------- //
 
-void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userData)
+void LexJsonFrom(const char* jsonString, const int length, const int offset, csmJsonTokenHandler onToken, void* userData)
 {
-  int tokenBegin, tokenEnd, lex;
+  int tokenBegin, tokenEnd, position, next, lex;
   csmJsonTokenType tokenType;
-  const char* string, * base;
-
-
-  // Initialize locals for lexing.
-  tokenType = InvalidToken;
-  string = jsonString;
-  base = jsonString;
+  const char* quote;
 
 
   // Lex.
-  for (lex = 1; *string != '\0' && lex; ++string)
+  for (lex = 1, position = offset; lex; )
   {
-    switch (*string)
+    // Skip to next token.
+    position = FindStructuralChar(jsonString, position, length);
+
+
+    if (position >= length)
+    {
+      break;
+    }
+
+
+    switch (jsonString[position])
     {
       case '{':
       {
         tokenType = csmJsonObjectBegin;
-        tokenBegin = (int)(string - base);
+        tokenBegin = position;
         tokenEnd = tokenBegin + 1;
 
 
@@ -61,7 +332,7 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       case '}':
       {
         tokenType = csmJsonObjectEnd;
-        tokenBegin = (int)(string - base);
+        tokenBegin = position;
         tokenEnd = tokenBegin + 1;
 
 
@@ -70,7 +341,7 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       case '[':
       {
         tokenType = csmJsonArrayBegin;
-        tokenBegin = (int)(string - base);
+        tokenBegin = position;
         tokenEnd = tokenBegin + 1;
 
 
@@ -79,7 +350,7 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       case ']':
       {
         tokenType = csmJsonArrayEnd;
-        tokenBegin = (int)(string - base);
+        tokenBegin = position;
         tokenEnd = tokenBegin + 1;
 
 
@@ -87,33 +358,54 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       }
       case '"':
       {
-        tokenBegin = (int)(string - base) + 1;
-        
+        tokenBegin = position + 1;
+
 
-        for (++string; *string != '"'; ++string)
+        // Find closing quote (and stop lexing if there's none).
+        quote = memchr(jsonString + tokenBegin, '"', (size_t)(length - tokenBegin));
+
+
+        if (!quote)
         {
-          ;
+          return;
         }
 
 
-        tokenEnd = (int)(string - base);
+        tokenEnd = (int)(quote - jsonString);
 
 
-        tokenType = (*(string + 1) == ':')
+        // Strings followed by a colon are names.
+        for (next = tokenEnd + 1; next < length && IsWhitespaceChar(jsonString[next]); ++next)
+        {
+          ;
+        }
+
+
+        tokenType = (next < length && jsonString[next] == ':')
           ? csmJsonName
           : csmJsonString;
 
 
+        position = tokenEnd;
+
+
         break;
       }
       case 't':
       {
         tokenType = csmJsonTrue;
-        tokenBegin = (int)(string - base);
-        tokenEnd = tokenBegin + (int)sizeof(True);
+        tokenBegin = position;
+        tokenEnd = tokenBegin + (int)(sizeof(True) - 1);
+
 
+        // Stop lexing on truncated literals.
+        if (tokenEnd > length)
+        {
+          return;
+        }
 
-        string += (tokenEnd - tokenBegin);
+
+        position = tokenEnd - 1;
 
 
         break;
@@ -121,11 +413,18 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       case 'f':
       {
         tokenType = csmJsonFalse;
-        tokenBegin = (int)(string - base);
-        tokenEnd = tokenBegin + (int)sizeof(False);
+        tokenBegin = position;
+        tokenEnd = tokenBegin + (int)(sizeof(False) - 1);
 
 
-        string += (tokenEnd - tokenBegin);
+        // Stop lexing on truncated literals.
+        if (tokenEnd > length)
+        {
+          return;
+        }
+
+
+        position = tokenEnd - 1;
 
 
         break;
@@ -133,31 +432,36 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
       case 'n':
       {
         tokenType = csmJsonNull;
-        tokenBegin = (int)(string - base);
-        tokenEnd = tokenBegin + (int)sizeof(Null);
+        tokenBegin = position;
+        tokenEnd = tokenBegin + (int)(sizeof(Null) - 1);
+
+
+        // Stop lexing on truncated literals.
+        if (tokenEnd > length)
+        {
+          return;
+        }
 
 
-        string += (tokenEnd - tokenBegin);
+        position = tokenEnd - 1;
 
 
         break;
       }
       default:
       {
-        if ((*string >= '0' && *string <= '9') || *string == '-')
-        {
-          tokenType = csmJsonNumber;
-          tokenBegin = (int)(string - base);
+        tokenType = csmJsonNumber;
+        tokenBegin = position;
 
 
-          for (; (*string >= '0' && *string <= '9') || *string == '-' || *string == '.'; ++string)
-          {
-            ;
-          }
+        for (; position < length && IsNumberChar(jsonString[position]); ++position)
+        {
+          ;
+        }
 
 
-          tokenEnd = (int)(string - base);
-        }
+        tokenEnd = position;
+        position = tokenEnd - 1;
 
 
         break;
@@ -165,14 +469,149 @@ void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userD
     }
 
 
-    // Do callback if token type is valid.
-    if (tokenType != InvalidToken)
+    // Do callback.
+    lex = onToken(jsonString, tokenType, tokenBegin, tokenEnd, userData);
+
+
+    // Move past last char of token.
+    ++position;
+  }
+}
+
+
+void csmLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userData)
+{
+  csmLexJsonWithLength(jsonString, (unsigned int)strlen(jsonString), onToken, userData);
+}
+
+void csmLexJsonWithLength(const char* jsonString, const unsigned int length, csmJsonTokenHandler onToken, void* userData)
+{
+  // Validate arguments.
+  Ensure(jsonString, "\"jsonString\" is invalid.", return);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return);
+
+
+  LexJsonFrom(jsonString, (int)length, 0, onToken, userData);
+}
+
+
+int csmLexJsonIntoTape(const char* jsonString, csmJsonToken* tape, const int capacity)
+{
+  // Validate argument.
+  Ensure(jsonString, "\"jsonString\" is invalid.", return 0);
+
+
+  return csmLexJsonIntoTapeWithLength(jsonString, (unsigned int)strlen(jsonString), tape, capacity);
+}
+
+int csmLexJsonIntoTapeWithLength(const char* jsonString, const unsigned int length, csmJsonToken* tape, const int capacity)
+{
+  TapeRecorderContext context;
+
+
+  // Validate argument.
+  Ensure(jsonString, "\"jsonString\" is invalid.", return 0);
+
+
+  // Initialize context.
+  context.Tape = tape;
+  context.Capacity = (tape)
+    ? capacity
+    : 0;
+  context.TokenCount = 0;
+
+
+  csmLexJsonWithLength(jsonString, length, RecordToken, &context);
+
+
+  return context.TokenCount;
+}
+
+void csmReplayJsonTape(const char* jsonString,
+                       const csmJsonToken* tape,
+                       const int tokenCount,
+                       csmJsonTokenHandler onToken,
+                       void* userData)
+{
+  ReplayJsonTapeFrom(jsonString, tape, tokenCount, 0, onToken, userData);
+}
+
+
+void ReplayJsonTapeFrom(const char* jsonString,
+                        const csmJsonToken* tape,
+                        const int tokenCount,
+                        const int offset,
+                        csmJsonTokenHandler onToken,
+                        void* userData)
+{
+  int t, lower, upper;
+
+
+  // Binary search first token at or behind offset.
+  for (lower = 0, upper = tokenCount; lower < upper; )
+  {
+    t = lower + ((upper - lower) / 2);
+
+
+    if (tape[t].Begin < offset)
+    {
+      lower = t + 1;
+    }
+    else
+    {
+      upper = t;
+    }
+  }
+
+
+  // Replay.
+  for (t = lower; t < tokenCount; ++t)
+  {
+    if (!onToken(jsonString, tape[t].Type, tape[t].Begin, tape[t].End, userData))
     {
-      lex = onToken(jsonString, tokenType, tokenBegin, tokenEnd, userData);
+      break;
     }
+  }
+}
+
+
+csmJsonToken* LexJsonIntoAllocatedTape(const char* jsonString,
+                                       const int length,
+                                       csmAllocateFunction allocate,
+                                       csmDeallocateFunction deallocate,
+                                       int* tokenCount)
+{
+  csmJsonToken* tape;
+  int capacity;
+
+
+  // Guess capacity from string length (assuming formatted JSONs take up at least 4 chars per token on average)...
+  capacity = (length / 4) + 64;
+  tape = allocate((unsigned int)(sizeof(csmJsonToken) * capacity));
+
 
+  Ensure(tape, "Failed to allocate token tape.", return 0);
 
-    // Reset condition for callback.
-    tokenType = InvalidToken;
+
+  *tokenCount = csmLexJsonIntoTapeWithLength(jsonString, (unsigned int)length, tape, capacity);
+
+
+  // ... and lex once more in the rare case the guess was too small.
+  if (*tokenCount > capacity)
+  {
+    deallocate(tape);
+
+
+    capacity = *tokenCount;
+    tape = allocate((unsigned int)(sizeof(csmJsonToken) * capacity));
+
+
+    Ensure(tape, "Failed to allocate token tape.", return 0);
+
+
+    *tokenCount = csmLexJsonIntoTapeWithLength(jsonString, (unsigned int)length, tape, capacity);
   }
+
+
+  return tape;
 }
@@ -10,6 +10,7 @@
 
 
 #include <Live2DCubismCore.h>
+#include <Live2DCubismFramework.h>
 #include <Live2DCubismFrameworkINTERNAL.h>
 
 
@@ -25,6 +26,71 @@ typedef struct csmAnimation csmAnimation;
 extern void Log(const char* message);
 
 
+// ---- //
+// SIMD //
+// ---- //
+
+// Select vector instruction sets from compiler flags unless explicitly disabled.
+#if !_CSM_COMPONENTS_DISABLE_SIMD
+  #if defined(__AVX2__)
+    #define _CSM_COMPONENTS_USE_AVX2 1
+  #endif
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define _CSM_COMPONENTS_USE_SSE2 1
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define _CSM_COMPONENTS_USE_NEON 1
+  #endif
+#endif
+
+
+#if _CSM_COMPONENTS_USE_AVX2
+  #include <immintrin.h>
+#elif _CSM_COMPONENTS_USE_SSE2
+  #include <emmintrin.h>
+#elif _CSM_COMPONENTS_USE_NEON
+  #include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+
+/// Finds index of lowest set bit.
+///
+/// @param  mask  Non-zero mask to scan.
+///
+/// @return  Index of lowest set bit.
+static inline int FindLowestSetBit(const unsigned long long mask)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+  unsigned long index;
+
+
+  _BitScanForward64(&index, mask);
+
+
+  return (int)index;
+#elif defined(_MSC_VER)
+  unsigned long index;
+
+
+  if (_BitScanForward(&index, (unsigned long)mask))
+  {
+    return (int)index;
+  }
+
+
+  _BitScanForward(&index, (unsigned long)(mask >> 32));
+
+
+  return (int)index + 32;
+#else
+  return __builtin_ctzll(mask);
+#endif
+}
+
+
 // ----- //
 // TYPES //
 // ----- //
@@ -32,6 +98,10 @@ extern void Log(const char* message);
 /// Meta data of a serialized motion.
 typedef struct MotionJsonMeta
 {
+  /// Version of serialized motion.
+  int Version;
+
+
   /// Duration of motion in seconds.
   float Duration;
 
@@ -51,6 +121,9 @@ typedef struct MotionJsonMeta
   /// Total number of points motion contains.
   int TotalPointCount;
 
+  /// Total number of bezier segments motion contains.
+  int TotalBezierCount;
+
 
   /// Non-zero if béziers are restricted; '0' otherwise.
   int AreBeziersRestricted;
@@ -107,26 +180,662 @@ while (0);
 // STRING //
 // ------ //
 
-/// Reads a float from a string.
+/// Scans a float in a locale-independent way, rounding it correctly.
+///
+/// @param  string  String to scan.
+/// @param  begin   Inclusive offset into string to start scanning at.
+/// @param  end     Exclusive offset into string to stop scanning at.
+/// @param  buffer  Buffer to write to.
+///
+/// @return  Offset behind float on success; 'begin' if there's no float to scan.
+int ScanFloat(const char* string, const int begin, const int end, float* buffer);
+
+/// Reads a float from a sub string.
 ///
 /// @param  string  String to read from.
+/// @param  begin   Inclusive offset into string to start reading at.
+/// @param  end     Exclusive offset into string to stop reading at.
 /// @param  buffer  Buffer to write to.
-void ReadFloatFromString(const char* string, float* buffer);
+void ReadFloatFromSubString(const char* string, const int begin, const int end, float* buffer);
 
-/// Reads an integer from a string.
+/// Reads an integer from a sub string.
 ///
 /// @param  string  String to read from.
+/// @param  begin   Inclusive offset into string to start reading at.
+/// @param  end     Exclusive offset into string to stop reading at.
 /// @param  buffer  Buffer to write to.
-void ReadIntFromString(const char* string, int* buffer);
+void ReadIntFromSubString(const char* string, const int begin, const int end, int* buffer);
 
 
-/// Checks whether a string begins with a given value.
+/// Checks whether a sub string begins with a given value.
 ///
 /// @param  string    String to check.
+/// @param  begin     Inclusive offset into string to start checking at.
+/// @param  end       Exclusive offset into string to stop checking at.
 /// @param  expected  Value to match against.
 ///
 /// @return Non-zero if expectation met; '0' otherwise.
-int DoesStringStartWith(const char* string, const char* expected);
+int DoesSubStringStartWith(const char* string, const int begin, const int end, const char* expected);
+
+
+// ---- //
+// JSON //
+// ---- //
+
+/// Lexes a JSON string of known length starting at an offset.
+///
+/// @param  jsonString  JSON string to lex.
+/// @param  length      Length of string (in chars).
+/// @param  offset      Offset into string to start lexing at (in chars).
+/// @param  onToken     Token handler.
+/// @param  userData    [Optional] Data to pass to token handler.
+void LexJsonFrom(const char* jsonString, const int length, const int offset, csmJsonTokenHandler onToken, void* userData);
+
+/// Replays a token tape starting at the first token at or behind an offset.
+///
+/// @param  jsonString  JSON string tape was lexed from.
+/// @param  tape        Tape to replay.
+/// @param  tokenCount  Number of tokens in tape.
+/// @param  offset      Offset into string to start replaying at (in chars).
+/// @param  onToken     Token handler.
+/// @param  userData    [Optional] Data to pass to token handler.
+void ReplayJsonTapeFrom(const char* jsonString,
+                        const csmJsonToken* tape,
+                        const int tokenCount,
+                        const int offset,
+                        csmJsonTokenHandler onToken,
+                        void* userData);
+
+
+/// Lexes a JSON string into a token tape allocated on demand.
+///
+/// @param  jsonString  JSON string to lex.
+/// @param  length      Length of string (in chars).
+/// @param  allocate    Function to allocate tape with.
+/// @param  deallocate  Function to free tape with if it has to be reallocated.
+/// @param  tokenCount  Number of tokens lexed.
+///
+/// @return  Valid tape on success; '0' otherwise.
+csmJsonToken* LexJsonIntoAllocatedTape(const char* jsonString,
+                                       const int length,
+                                       csmAllocateFunction allocate,
+                                       csmDeallocateFunction deallocate,
+                                       int* tokenCount);
+
+
+// --------- //
+// ANIMATION //
+// --------- //
+
+/// Gets curves of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Curves.
+static inline csmAnimationCurve* GetAnimationCurves(const csmAnimation* animation)
+{
+  return (csmAnimationCurve*)((const char*)animation + animation->CurvesOffset);
+}
+
+/// Gets segments of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Segments.
+static inline csmAnimationSegment* GetAnimationSegments(const csmAnimation* animation)
+{
+  return (csmAnimationSegment*)((const char*)animation + animation->SegmentsOffset);
+}
+
+/// Gets type of a segment.
+///
+/// @param  segment  Segment to query.
+///
+/// @return  Segment type.
+static inline int GetAnimationSegmentType(const csmAnimationSegment* segment)
+{
+  return (int)(segment->TypeAndBasePointIndex >> csmAnimationSegmentTypeShift);
+}
+
+/// Gets index of first point of a segment.
+///
+/// @param  segment  Segment to query.
+///
+/// @return  Index of first segment point.
+static inline int GetAnimationSegmentBasePointIndex(const csmAnimationSegment* segment)
+{
+  return (int)(segment->TypeAndBasePointIndex & csmAnimationSegmentBasePointIndexMask);
+}
+
+/// Initializes a segment.
+///
+/// Point indices always fit, as motion JSONs are limited to 'INT_MAX' characters.
+///
+/// @param  segment         Segment to initialize.
+/// @param  type            Segment type.
+/// @param  basePointIndex  Index of first segment point.
+static inline void InitializeAnimationSegment(csmAnimationSegment* segment, const int type, const int basePointIndex)
+{
+  segment->TypeAndBasePointIndex = ((unsigned int)type << csmAnimationSegmentTypeShift)
+    | ((unsigned int)basePointIndex & csmAnimationSegmentBasePointIndexMask);
+}
+
+/// Gets points of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Points.
+static inline csmAnimationPoint* GetAnimationPoints(const csmAnimation* animation)
+{
+  return (csmAnimationPoint*)((const char*)animation + animation->PointsOffset);
+}
+
+/// Gets bezier polynomials of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Polynomials (one per bezier segment).
+static inline csmAnimationBezierPolynomial* GetAnimationBezierPolynomials(const csmAnimation* animation)
+{
+  return (csmAnimationBezierPolynomial*)((const char*)animation + animation->BezierPolynomialsOffset);
+}
+
+/// Gets bezier time polynomials of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Polynomials (indexed like bezier polynomials) if béziers are unrestricted; '0' otherwise.
+static inline csmAnimationBezierTimePolynomial* GetAnimationBezierTimePolynomials(const csmAnimation* animation)
+{
+  return (animation->BezierTimePolynomialsOffset)
+    ? (csmAnimationBezierTimePolynomial*)((const char*)animation + animation->BezierTimePolynomialsOffset)
+    : 0;
+}
+
+/// Gets the index of the bezier polynomial of a segment.
+///
+/// Consecutive segments of a curve share a point, and bezier segments take 2 points more than others,
+/// so the number of béziers preceding a segment in its curve follows from its base point.
+///
+/// @param  animation     Animation containing curve.
+/// @param  curve         Curve containing segment.
+/// @param  segmentIndex  Index of bezier segment.
+///
+/// @return  Polynomial index.
+static inline int GetAnimationBezierIndex(const csmAnimation* animation, const csmAnimationCurve* curve, const int segmentIndex)
+{
+  const csmAnimationSegment* segments;
+  int pointOffset;
+
+
+  segments = GetAnimationSegments(animation);
+  pointOffset = GetAnimationSegmentBasePointIndex(segments + segmentIndex)
+    - GetAnimationSegmentBasePointIndex(segments + curve->BaseSegmentIndex);
+
+
+  return curve->BaseBezierIndex + ((pointOffset - (segmentIndex - curve->BaseSegmentIndex)) / 2);
+}
+
+
+/// Aligns the offset of a lazy source (as it holds a pointer).
+///
+/// @param  offset  Offset to align (in bytes).
+///
+/// @return  Aligned offset.
+static inline int AlignLazySourceOffset(const int offset)
+{
+  return (int)(((unsigned int)offset + (sizeof(void*) - 1)) & ~(unsigned int)(sizeof(void*) - 1));
+}
+
+/// Gets the lazy source of an animation.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Lazy source if animation has curves left to decode; '0' otherwise.
+static inline csmAnimationLazySource* GetAnimationLazySource(const csmAnimation* animation)
+{
+  return (animation->LazySourceOffset)
+    ? (csmAnimationLazySource*)((const char*)animation + animation->LazySourceOffset)
+    : 0;
+}
+
+/// Gets the offsets of the segments arrays of an animation into its serialized motion.
+///
+/// @param  animation  Animation to query.
+///
+/// @return  Offsets (indexed like curves) if animation has curves left to decode; '0' otherwise.
+static inline int* GetAnimationLazySegmentsPositions(const csmAnimation* animation)
+{
+  return (animation->LazySourceOffset)
+    ? (int*)(GetAnimationLazySource(animation) + 1)
+    : 0;
+}
+
+
+/// Decodes a curve of a lazily deserialized animation.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+void DecodeLazyAnimationCurve(csmAnimation* animation, const int index);
+
+/// Decodes a curve of an animation unless it's decoded already.
+///
+/// Lazily deserialized animations are updated in place, so evaluating them isn't thread-safe until all curves are decoded.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+static inline void DecodeAnimationCurveOnDemand(const csmAnimation* animation, const int index)
+{
+  if (GetAnimationCurves(animation)[index].SegmentCount < 0)
+  {
+    DecodeLazyAnimationCurve((csmAnimation*)animation, index);
+  }
+}
+
+
+/// Evaluates a curve of an animation.
+///
+/// @param  animation     Animation containing curve.
+/// @param  index         Curve index.
+/// @param  time          Time to evaluate at.
+/// @param  segmentIndex  [Optional] Index of segment evaluated last (updated on return).
+///
+/// @return  Value at time.
+float EvaluateAnimationCurve(const csmAnimation* animation, const int index, float time, int* segmentIndex);
+
+
+/// Computes bezier polynomials of an animation from its segments and points.
+///
+/// Time polynomials are computed, too, if the animation has room for them.
+/// If all béziers turn out to be restricted, they're dropped again so that evaluation takes the restricted path.
+///
+/// @param  animation  Animation to update.
+void InitializeAnimationBezierPolynomials(csmAnimation* animation);
+
+/// Computes bezier polynomials of a range of segments.
+///
+/// @param  animation     Animation to update.
+/// @param  firstSegment  Index of first segment.
+/// @param  segmentCount  Number of segments.
+/// @param  firstBezier   Index of polynomial of first bezier segment in range.
+///
+/// @return  Non-zero if all béziers in range are restricted; '0' otherwise.
+int InitializeAnimationBezierPolynomialRange(csmAnimation* animation,
+                                             const int firstSegment,
+                                             const int segmentCount,
+                                             const int firstBezier);
+
+/// Classifies curves of an animation as constant or static after some time.
+///
+/// @param  animation  Animation to update.
+void InitializeAnimationStaticCurves(csmAnimation* animation);
+
+/// Classifies a curve of an animation as constant or static after some time.
+///
+/// @param  animation  Animation to update.
+/// @param  index      Curve index.
+void InitializeAnimationStaticCurve(csmAnimation* animation, const int index);
+
+/// Gets the points a curve references.
+///
+/// @param  animation       Animation containing curve.
+/// @param  curve           Curve to query.
+/// @param  basePointIndex  Index of first point of curve.
+/// @param  pointCount      Number of points of curve.
+///
+/// @return  Non-zero if curve references segments and points in range only; '0' otherwise.
+int GetAnimationCurvePointRange(const csmAnimation* animation, const csmAnimationCurve* curve, int* basePointIndex, int* pointCount);
+
+/// Solves a bezier time polynomial for the curve parameter.
+///
+/// @param  a     Cubic coefficient of time polynomial.
+/// @param  b     Quadratic coefficient of time polynomial.
+/// @param  c     Linear coefficient of time polynomial.
+/// @param  time  Normalized time to solve for.
+///
+/// @return  Curve parameter in '[0, 1]'.
+float SolveBezierTimePolynomial(const float a, const float b, const float c, const float time);
+
+
+/// Interpolates linearly between 2 values.
+///
+/// @param  startTime   Time of start value.
+/// @param  duration    Time between values.
+/// @param  startValue  Start value.
+/// @param  valueDelta  Difference between values.
+/// @param  time        Time to interpolate at.
+///
+/// @return  Value at time.
+static inline float InterpolateLinearly(const float startTime,
+                                        const float duration,
+                                        const float startValue,
+                                        const float valueDelta,
+                                        const float time)
+{
+  float t;
+
+
+  t = (time - startTime) / duration;
+
+
+  return startValue + (valueDelta * t);
+}
+
+/// Evaluates a cubic polynomial in Horner form.
+///
+/// @param  a  Cubic coefficient.
+/// @param  b  Quadratic coefficient.
+/// @param  c  Linear coefficient.
+/// @param  d  Constant coefficient.
+/// @param  t  Parameter to evaluate at.
+///
+/// @return  Value at parameter.
+static inline float EvaluateCubicPolynomial(const float a, const float b, const float c, const float d, const float t)
+{
+  float value;
+
+
+  value = a;
+  value = (value * t) + b;
+  value = (value * t) + c;
+
+
+  return (value * t) + d;
+}
+
+
+#if _CSM_COMPONENTS_USE_AVX2
+/// Interpolates linearly between 8 pairs of values at once (see 'InterpolateLinearly()').
+///
+/// @param  startTimes   Times of start values.
+/// @param  durations    Times between values.
+/// @param  startValues  Start values.
+/// @param  valueDeltas  Differences between values.
+/// @param  times        Times to interpolate at.
+///
+/// @return  Values at times.
+static inline __m256 InterpolateLinearly8(const __m256 startTimes,
+                                          const __m256 durations,
+                                          const __m256 startValues,
+                                          const __m256 valueDeltas,
+                                          const __m256 times)
+{
+  __m256 t;
+
+
+  t = _mm256_div_ps(_mm256_sub_ps(times, startTimes), durations);
+
+
+  return _mm256_add_ps(startValues, _mm256_mul_ps(valueDeltas, t));
+}
+
+/// Evaluates 8 cubic polynomials at once (see 'EvaluateCubicPolynomial()').
+///
+/// @param  a  Cubic coefficients.
+/// @param  b  Quadratic coefficients.
+/// @param  c  Linear coefficients.
+/// @param  d  Constant coefficients.
+/// @param  t  Parameters to evaluate at.
+///
+/// @return  Values at parameters.
+static inline __m256 EvaluateCubicPolynomial8(const __m256 a, const __m256 b, const __m256 c, const __m256 d, const __m256 t)
+{
+  __m256 value;
+
+
+  value = a;
+  value = _mm256_add_ps(_mm256_mul_ps(value, t), b);
+  value = _mm256_add_ps(_mm256_mul_ps(value, t), c);
+
+
+  return _mm256_add_ps(_mm256_mul_ps(value, t), d);
+}
+#endif
+
+#if _CSM_COMPONENTS_USE_SSE2
+/// Interpolates linearly between 4 pairs of values at once (see 'InterpolateLinearly()').
+///
+/// @param  startTimes   Times of start values.
+/// @param  durations    Times between values.
+/// @param  startValues  Start values.
+/// @param  valueDeltas  Differences between values.
+/// @param  times        Times to interpolate at.
+///
+/// @return  Values at times.
+static inline __m128 InterpolateLinearly4(const __m128 startTimes,
+                                          const __m128 durations,
+                                          const __m128 startValues,
+                                          const __m128 valueDeltas,
+                                          const __m128 times)
+{
+  __m128 t;
+
+
+  t = _mm_div_ps(_mm_sub_ps(times, startTimes), durations);
+
+
+  return _mm_add_ps(startValues, _mm_mul_ps(valueDeltas, t));
+}
+
+/// Evaluates 4 cubic polynomials at once (see 'EvaluateCubicPolynomial()').
+///
+/// @param  a  Cubic coefficients.
+/// @param  b  Quadratic coefficients.
+/// @param  c  Linear coefficients.
+/// @param  d  Constant coefficients.
+/// @param  t  Parameters to evaluate at.
+///
+/// @return  Values at parameters.
+static inline __m128 EvaluateCubicPolynomial4(const __m128 a, const __m128 b, const __m128 c, const __m128 d, const __m128 t)
+{
+  __m128 value;
+
+
+  value = a;
+  value = _mm_add_ps(_mm_mul_ps(value, t), b);
+  value = _mm_add_ps(_mm_mul_ps(value, t), c);
+
+
+  return _mm_add_ps(_mm_mul_ps(value, t), d);
+}
+#elif _CSM_COMPONENTS_USE_NEON && defined(__aarch64__)
+/// Interpolates linearly between 4 pairs of values at once (see 'InterpolateLinearly()').
+///
+/// @param  startTimes   Times of start values.
+/// @param  durations    Times between values.
+/// @param  startValues  Start values.
+/// @param  valueDeltas  Differences between values.
+/// @param  times        Times to interpolate at.
+///
+/// @return  Values at times.
+static inline float32x4_t InterpolateLinearly4(const float32x4_t startTimes,
+                                               const float32x4_t durations,
+                                               const float32x4_t startValues,
+                                               const float32x4_t valueDeltas,
+                                               const float32x4_t times)
+{
+  float32x4_t t;
+
+
+  t = vdivq_f32(vsubq_f32(times, startTimes), durations);
+
+
+  return vaddq_f32(startValues, vmulq_f32(valueDeltas, t));
+}
+
+/// Evaluates 4 cubic polynomials at once (see 'EvaluateCubicPolynomial()').
+///
+/// @param  a  Cubic coefficients.
+/// @param  b  Quadratic coefficients.
+/// @param  c  Linear coefficients.
+/// @param  d  Constant coefficients.
+/// @param  t  Parameters to evaluate at.
+///
+/// @return  Values at parameters.
+static inline float32x4_t EvaluateCubicPolynomial4(const float32x4_t a,
+                                                   const float32x4_t b,
+                                                   const float32x4_t c,
+                                                   const float32x4_t d,
+                                                   const float32x4_t t)
+{
+  float32x4_t value;
+
+
+  value = a;
+  value = vaddq_f32(vmulq_f32(value, t), b);
+  value = vaddq_f32(vmulq_f32(value, t), c);
+
+
+  return vaddq_f32(vmulq_f32(value, t), d);
+}
+#endif
+
+
+/// Evaluates a bezier segment in polynomial form.
+///
+/// @param  polynomial  Polynomial to evaluate.
+/// @param  time        Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateBezierPolynomial(const csmAnimationBezierPolynomial* polynomial, const float time)
+{
+  return EvaluateCubicPolynomial(polynomial->Coefficients[0],
+                                 polynomial->Coefficients[1],
+                                 polynomial->Coefficients[2],
+                                 polynomial->Coefficients[3],
+                                 (time - polynomial->StartTime) * polynomial->InverseDuration);
+}
+
+/// Evaluates an unrestricted bezier segment in polynomial form.
+///
+/// @param  polynomial      Polynomial to evaluate.
+/// @param  timePolynomial  Time polynomial of segment.
+/// @param  time            Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateUnrestrictedBezierPolynomial(const csmAnimationBezierPolynomial* polynomial,
+                                                         const csmAnimationBezierTimePolynomial* timePolynomial,
+                                                         const float time)
+{
+  float t;
+
+
+  t = SolveBezierTimePolynomial(timePolynomial->Coefficients[0],
+                                timePolynomial->Coefficients[1],
+                                timePolynomial->Coefficients[2],
+                                (time - polynomial->StartTime) * polynomial->InverseDuration);
+
+
+  return EvaluateCubicPolynomial(polynomial->Coefficients[0],
+                                 polynomial->Coefficients[1],
+                                 polynomial->Coefficients[2],
+                                 polynomial->Coefficients[3],
+                                 t);
+}
+
+
+/// Evaluates a linear segment.
+///
+/// @param  points  Points of segment.
+/// @param  time    Time to evaluate at.
+///
+/// @return  Value at time.
+static inline float EvaluateLinearAnimationSegment(const csmAnimationPoint* points, const float time)
+{
+  return InterpolateLinearly(points[0].Time,
+                             points[1].Time - points[0].Time,
+                             points[0].Value,
+                             points[1].Value - points[0].Value,
+                             time);
+}
+
+
+/// 'Repeats' time of an animation as necessary.
+///
+/// @param  animation  Animation to evaluate.
+/// @param  state      Animation state.
+///
+/// @return  Time to evaluate animation at.
+static inline float GetAnimationTime(const csmAnimation* animation, const csmAnimationState* state)
+{
+  float time;
+
+
+  time = state->Time;
+
+
+  if (animation->Loop)
+  {
+    while (time > animation->Duration)
+    {
+      time -= animation->Duration;
+    }
+  }
+
+
+  return time;
+}
+
+/// Finds segment of a curve that contains a given time.
+///
+/// Checks the hinted segment and its successor first (as is the case for forward playback)
+/// and falls back to a binary search over segment start times.
+///
+/// @param  segments      First segment of curve.
+/// @param  segmentCount  Number of segments of curve.
+/// @param  points        Points of animation.
+/// @param  time          Time to look up.
+/// @param  hint          Index of segment to check first.
+///
+/// @return  Index of segment relative to first segment.
+static inline int FindAnimationSegment(const csmAnimationSegment* segments,
+                                       const int segmentCount,
+                                       const csmAnimationPoint* points,
+                                       const float time,
+                                       const int hint)
+{
+  int first, last, middle, s;
+
+
+  // Check hinted segment and next one.
+  for (s = hint; s <= (hint + 1) && s >= 0 && s < segmentCount; ++s)
+  {
+    if (s > 0 && points[GetAnimationSegmentBasePointIndex(segments + s)].Time > time)
+    {
+      break;
+    }
+
+
+    if (s == (segmentCount - 1) || points[GetAnimationSegmentBasePointIndex(segments + s + 1)].Time > time)
+    {
+      return s;
+    }
+  }
+
+
+  // Search last segment starting at or before time.
+  first = 0;
+  last = segmentCount - 1;
+
+
+  while (first < last)
+  {
+    middle = first + ((last - first + 1) / 2);
+
+
+    if (points[GetAnimationSegmentBasePointIndex(segments + middle)].Time > time)
+    {
+      last = middle - 1;
+    }
+    else
+    {
+      first = middle;
+    }
+  }
+
+
+  return first;
+}
 
 
 // ----------- //
@@ -136,25 +845,80 @@ int DoesStringStartWith(const char* string, const char* expected);
 /// Reads serialized motion meta.
 ///
 /// @param  motionJson  Motion JSON string.
+/// @param  length      Length of JSON string (in chars).
+/// @param  tape        [Optional] Token tape of JSON string to replay instead of lexing.
+/// @param  tokenCount  Number of tokens in tape.
 /// @param  buffer      Buffer to read into.
-void ReadMotionJsonMeta(const char* motionJson, MotionJsonMeta* buffer);
+///
+/// @return  Non-zero on success; '0' if version is unsupported or meta is incomplete.
+int ReadMotionJsonMeta(const char* motionJson, const int length, const csmJsonToken* tape, const int tokenCount, MotionJsonMeta* buffer);
 
 /// Reads a serialized motion.
 ///
 /// @param  motionJson  Motion JSON string.
+/// @param  length      Length of JSON string (in chars).
+/// @param  tape        [Optional] Token tape of JSON string to replay instead of lexing.
+/// @param  tokenCount  Number of tokens in tape.
+/// @param  meta        Meta read from JSON string before (see 'ReadMotionJsonMeta()').
 /// @param  buffer      Buffer to read into.
-void ReadMotionJson(const char* motionJson, csmAnimation* buffer);
+///
+/// @return  Non-zero on success; '0' if motion JSON is invalid.
+int ReadMotionJson(const char* motionJson,
+                   const int length,
+                   const csmJsonToken* tape,
+                   const int tokenCount,
+                   const MotionJsonMeta* meta,
+                   csmAnimation* buffer);
+
+/// Reads a serialized motion, only recording where the segments of each curve are.
+///
+/// @param  motionJson  Motion JSON string (has to outlive decoding).
+/// @param  length      Length of JSON string (in chars).
+/// @param  meta        Meta read from JSON string before (see 'ReadMotionJsonMeta()').
+/// @param  buffer      Buffer to read into.
+///
+/// @return  Non-zero on success; '0' if motion JSON is invalid.
+int ReadMotionJsonLazily(const char* motionJson, const int length, const MotionJsonMeta* meta, csmAnimation* buffer);
+
+/// Reads the segments of a curve of a lazily read motion.
+///
+/// @param  animation  Animation containing curve.
+/// @param  index      Curve index.
+void ReadLazyMotionJsonCurve(csmAnimation* animation, const int index);
 
 
 // ------------ //
 // PHYSICS JSON //
 // ------------ //
 
-// TODO Document
-void ReadPhysicsJsonMeta(const char* physicsJson, PhysicsJsonMeta* buffer);
+/// Reads serialized physics meta.
+///
+/// @param  physicsJson  Physics JSON string.
+/// @param  length       Length of JSON string (in chars).
+/// @param  tape         [Optional] Token tape of JSON string to replay instead of lexing.
+/// @param  tokenCount   Number of tokens in tape.
+/// @param  buffer       Buffer to read into.
+void ReadPhysicsJsonMeta(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount, PhysicsJsonMeta* buffer);
+
+/// Reads serialized physics.
+///
+/// @param  physicsJson  Physics JSON string.
+/// @param  length       Length of JSON string (in chars).
+/// @param  tape         [Optional] Token tape of JSON string to replay instead of lexing.
+/// @param  tokenCount   Number of tokens in tape.
+/// @param  buffer       Buffer to read into.
+void ReadPhysicsJson(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount, csmPhysicsRig* buffer);
 
-// TODO Document
-void ReadPhysicsJson(const char* physicsJson, csmPhysicsRig* buffer);
+
+/// Binds evaluation functions of a physics input according to its type.
+///
+/// @param  input  Input to bind.
+void BindPhysicsInput(csmPhysicsInput* input);
+
+/// Binds evaluation functions of a physics output according to its type.
+///
+/// @param  output  Output to bind.
+void BindPhysicsOutput(csmPhysicsOutput* output);
 
 
 // ------------ //
@@ -16,6 +16,9 @@
 #include <Live2DCubismFramework.h>
 #include <Live2DCubismFrameworkINTERNAL.h>
 
+#include <float.h>
+#include <limits.h>
+
 
 // ----- //
 // TYPES //
@@ -88,6 +91,9 @@ typedef enum ParserState
 
   // Flag for motion parser to read curve segments data.
   ReadingSegments,
+
+  // Flag for motion parser to hand over reading curve segments data to bulk reader.
+  ReadingSegmentsInBulk,
 }
 ParserState;
 
@@ -131,6 +137,9 @@ typedef struct MotionParserContext
   /// Current offset into buffer points array.
   int PointIndex;
 
+  /// Current offset into buffer bezier polynomials array.
+  int BezierIndex;
+
 
   /// Position in segment being parsed.
   int SegmentValueIndex;
@@ -141,17 +150,39 @@ typedef struct MotionParserContext
   /// Non-zero if point time should be parsed. 
   int ReadPointTime;
 
+  /// Offset into JSON string to start reading segments in bulk at.
+  int BulkPosition;
 
-  /// Motion meta data.
-  MotionJsonMeta Meta;
+  /// [Optional] Buffer to record offsets of segments arrays to (instead of reading segments).
+  int* SegmentsPositions;
 
 
   /// Buffer to write to.
   csmAnimation* Buffer;
+
+  /// Curves of buffer.
+  csmAnimationCurve* Curves;
+
+  /// Segments of buffer.
+  csmAnimationSegment* Segments;
+
+  /// Points of buffer.
+  csmAnimationPoint* Points;
 }
 MotionParserContext;
 
 
+/// Bulk segment reader.
+///
+/// @param  jsonString  Serialized motion.
+/// @param  length      Length of serialized motion (in chars).
+/// @param  position    Offset into string behind array begin.
+/// @param  context     Parser context.
+///
+/// @return  Offset into string to resume lexing at.
+typedef int (*SegmentsReader)(const char* jsonString, const int length, int position, MotionParserContext* context);
+
+
 // --------------------------- //
 // VERSION INDEPENDENT PARSERS //
 // --------------------------- //
@@ -196,7 +227,7 @@ static int ParseVersion(const char* jsonString, csmJsonTokenType type, int begin
       }
 
 
-      else if (DoesStringStartWith(jsonString + begin, "Version"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Version"))
       {
         context->State = ReadingVersion;
       }
@@ -209,7 +240,7 @@ static int ParseVersion(const char* jsonString, csmJsonTokenType type, int begin
     // ... then read version.
     case ReadingVersion:
     {
-      ReadIntFromString(jsonString + begin, context->Buffer);
+      ReadIntFromSubString(jsonString, begin, end, context->Buffer);
 
 
       context->State = FinishedParsing;
@@ -239,6 +270,14 @@ static void InitializeMetaParserContext(MetaParserContext* context, MotionJsonMe
 {
   context->State = Pending;
   context->Buffer = buffer;
+  context->Buffer->Version = 0;
+  context->Buffer->Duration = 0.0f;
+  context->Buffer->Fps = 0.0f;
+  context->Buffer->Loop = 0;
+  context->Buffer->CurveCount = 0;
+  context->Buffer->TotalSegmentCount = 0;
+  context->Buffer->TotalPointCount = 0;
+  context->Buffer->TotalBezierCount = 0;
   context->Buffer->AreBeziersRestricted = 0;
 }
 
@@ -253,14 +292,16 @@ static void InitializeMotionParserContext(MotionParserContext* context, csmAnima
   context->CurveIndex = 0;
   context->SegmentIndex = 0;
   context->PointIndex = 0;
+  context->BezierIndex = 0;
   context->SegmentValueIndex = 0;
   context->SegmentTypePosition = 0;
   context->ReadPointTime = 0;
+  context->BulkPosition = 0;
+  context->SegmentsPositions = 0;
   context->Buffer = buffer;
-
-
-  // 'Flag' buffer as uninitialized...
-  context->Buffer->Curves = 0;
+  context->Curves = 0;
+  context->Segments = 0;
+  context->Points = 0;
 }
 
 
@@ -297,7 +338,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       }
 
 
-      else if (DoesStringStartWith(jsonString + begin, "Meta"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Meta"))
       {
         context->State = Waiting;
       }
@@ -320,31 +361,31 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       // Select data to read.
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "Duration"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "Duration"))
         {
           context->State = ReadingDuration;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Fps"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Fps"))
         {
           context->State = ReadingFps;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Loop"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Loop"))
         {
           context->State = ReadingLoop;
         }
-        else if (DoesStringStartWith(jsonString + begin, "CurveCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "CurveCount"))
         {
           context->State = ReadingCurveCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "TotalSegmentCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "TotalSegmentCount"))
         {
           context->State = ReadingTotalSegmentCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "TotalPointCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "TotalPointCount"))
         {
           context->State = ReadingTotalPointCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "AreBeziersRestricted"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "AreBeziersRestricted"))
         {
           context->State = ReadingAreBeziersRestricted;
         }
@@ -358,7 +399,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // Read duration.
     case ReadingDuration:
     {
-      ReadFloatFromString(jsonString + begin, &context->Buffer->Duration);
+      ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Duration);
 
 
       context->State = Waiting;
@@ -371,7 +412,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // Read fps.
     case ReadingFps:
     {
-       ReadFloatFromString(jsonString + begin, &context->Buffer->Fps);
+       ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Fps);
 
 
       context->State = Waiting;
@@ -397,7 +438,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // Read curve count.
     case ReadingCurveCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->CurveCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->CurveCount);
 
 
       context->State = Waiting;
@@ -410,7 +451,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // Read segment count.
     case ReadingTotalSegmentCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->TotalSegmentCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->TotalSegmentCount);
 
 
       context->State = Waiting;
@@ -423,7 +464,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // Read point count.
     case ReadingTotalPointCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->TotalPointCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->TotalPointCount);
 
 
       context->State = Waiting;
@@ -467,37 +508,13 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
 /// @param  metaParserContext  Parser context.
 static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin, int end, void* motionParserContext)
 {
-  MetaParserContext metaParserContext;
   MotionParserContext* context;
-  int segmentType;
 
 
   // Recover context.
   context = motionParserContext;
 
 
-  // Initialize meta related fields if necessary.
-  if (!context->Buffer->Curves)
-  {
-    // Parse meta.
-    InitializeMetaParserContext(&metaParserContext, &context->Meta);
-    csmLexJson(jsonString, ParseMeta3, &metaParserContext);
-
-
-    // Initialize data fields.
-    context->Buffer->Duration = context->Meta.Duration;
-    context->Buffer->Loop = (short)context->Meta.Loop;
-
-    context->Buffer->CurveCount = (short)context->Meta.CurveCount;
-
-
-    // Initialize pointer fields.
-    context->Buffer->Curves = (csmAnimationCurve*)(context->Buffer + 1);
-    context->Buffer->Segments = (csmAnimationSegment*)(context->Buffer->Curves + context->Meta.CurveCount);
-    context->Buffer->Points = (csmAnimationPoint*)(context->Buffer->Segments + context->Meta.TotalSegmentCount);
-  }
-
-
   // Handle token.
   switch (context->State)
   {
@@ -511,7 +528,7 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
       }
 
 
-      else if (DoesStringStartWith(jsonString + begin, "Curves"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Curves"))
       {
         context->State = Waiting;
       }
@@ -535,7 +552,8 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
       else if (type == csmJsonObjectBegin)
       {
         // Initialize curve fields.
-        context->Buffer->Curves[context->CurveIndex].BaseSegmentIndex = context->SegmentIndex;
+        context->Curves[context->CurveIndex].BaseSegmentIndex = context->SegmentIndex;
+        context->Curves[context->CurveIndex].BaseBezierIndex = context->BezierIndex;
 
 
         // Prepare context.
@@ -554,7 +572,7 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
       if (type == csmJsonObjectEnd)
       {
         // Finalize curve fields.
-        context->Buffer->Curves[context->CurveIndex].SegmentCount = context->SegmentIndex - context->Buffer->Curves[context->CurveIndex].BaseSegmentIndex;
+        context->Curves[context->CurveIndex].SegmentCount = context->SegmentIndex - context->Curves[context->CurveIndex].BaseSegmentIndex;
 
 
         // Update context.
@@ -567,15 +585,15 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
       // Prepare context for reading curve data.
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "Target"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "Target"))
         {
           context->State = ReadingTarget;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Id"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Id"))
         {
           context->State = ReadingId;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Segments"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Segments"))
         {
           context->SegmentValueIndex = 0;
           context->SegmentTypePosition = 2;
@@ -594,17 +612,17 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
     // Read curve target.
     case ReadingTarget:
     {
-      if (DoesStringStartWith(jsonString + begin, "Model"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Model"))
       {
-        context->Buffer->Curves[context->CurveIndex].Type = csmModelAnimationCurve;
+        context->Curves[context->CurveIndex].Type = csmModelAnimationCurve;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Parameter"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Parameter"))
       {
-        context->Buffer->Curves[context->CurveIndex].Type = csmParameterAnimationCurve;
+        context->Curves[context->CurveIndex].Type = csmParameterAnimationCurve;
       }
-      else if (DoesStringStartWith(jsonString + begin, "PartOpacity"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "PartOpacity"))
       {
-        context->Buffer->Curves[context->CurveIndex].Type = csmPartOpacityAnimationCurve;
+        context->Curves[context->CurveIndex].Type = csmPartOpacityAnimationCurve;
       }
 
       
@@ -620,26 +638,26 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
     case ReadingId:
     {
       // Hash ID..
-      if (context->Buffer->Curves[context->CurveIndex].Type != csmModelAnimationCurve)
+      if (context->Curves[context->CurveIndex].Type != csmModelAnimationCurve)
       {
-        context->Buffer->Curves[context->CurveIndex].Id = csmHashIdFromSubString(jsonString, begin, end);
+        context->Curves[context->CurveIndex].Id = csmHashIdFromSubString(jsonString, begin, end);
       }
 
 
       // ... Assign model curve target.
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "Opacity"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "Opacity"))
         {
-          context->Buffer->Curves[context->CurveIndex].Id = csmOpacityAnimationCurve;
+          context->Curves[context->CurveIndex].Id = csmOpacityAnimationCurve;
         }
-        else if (DoesStringStartWith(jsonString + begin, "EyeBlink"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "EyeBlink"))
         {
-          context->Buffer->Curves[context->CurveIndex].Id = csmEyeBlinkAnimationCurve;
+          context->Curves[context->CurveIndex].Id = csmEyeBlinkAnimationCurve;
         }
-        else if (DoesStringStartWith(jsonString + begin, "LipSync"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "LipSync"))
         {
-          context->Buffer->Curves[context->CurveIndex].Id = csmLipSyncAnimationCurve;
+          context->Curves[context->CurveIndex].Id = csmLipSyncAnimationCurve;
         }
       }
 
@@ -652,119 +670,196 @@ static int ParseMotion3(const char* jsonString, csmJsonTokenType type, int begin
     }
 
 
-    // Read curve segments.
+    // Stop lexing at begin of segments so they can be read in bulk.
     case ReadingSegments:
     {
-      // Finalize segment parsing.
-      if (type == csmJsonArrayEnd)
+      if (type == csmJsonArrayBegin)
       {
-        context->State = ReadingCurve;
+        context->BulkPosition = end;
+
+        context->State = ReadingSegmentsInBulk;
       }
 
 
-      else
+      break;
+    }
+
+
+    default:
+    {
+      break;
+    }
+  }
+
+
+  return context->State != FinishedParsing && context->State != ReadingSegmentsInBulk;
+}
+
+
+/// Reads a single value of curve segments.
+///
+/// @param  context  Parser context.
+/// @param  value    Value to read.
+static void ReadSegmentValue(MotionParserContext* context, const float value)
+{
+  int segmentType, type;
+
+
+  // Read segment type.
+  if (context->SegmentValueIndex == context->SegmentTypePosition)
+  {
+    segmentType = (int)value;
+
+    // Treat unknown segment types as linear.
+    type = csmLinearAnimationSegment;
+
+
+    switch (segmentType)
+    {
+      case LinearSegment:
       {
-        // Skip array token.
-        if (type == csmJsonArrayBegin)
-        {
-        }
+        type = csmLinearAnimationSegment;
 
 
-        // Read segment type.
-        else if (context->SegmentValueIndex == context->SegmentTypePosition)
-        {
-          // Read data.
-          ReadIntFromString(jsonString + begin, &segmentType);
+        break;
+      }
+      case BezierSegment:
+      {
+        type = csmBezierAnimationSegment;
 
 
-          switch (segmentType)
-          {
-            case LinearSegment:
-            {
-              context->Buffer->Segments[context->SegmentIndex].Evaluate = csmLinearAnimationSegmentEvaluationFunction;
+        break;
+      }
+      case SteppedSegment:
+      {
+        type = csmSteppedAnimationSegment;
 
 
-              break;
-            }
-            case BezierSegment:
-            {
-              context->Buffer->Segments[context->SegmentIndex].Evaluate = csmBezierAnimationSegmentEvaluationFunction;
+        break;
+      }
+      case InverseSteppedSegment:
+      {
+        type = csmInverseSteppedAnimationSegment;
 
 
-              break;
-            }
-            case SteppedSegment:
-            {
-              context->Buffer->Segments[context->SegmentIndex].Evaluate = csmSteppedAnimationSegmentEvaluationFunction;
+        break;
+      }
+    }
 
 
-              break;
-            }
-            case InverseSteppedSegment:
-            {
-              context->Buffer->Segments[context->SegmentIndex].Evaluate = csmInverseSteppedAnimationSegmentEvaluationFunction;
+    InitializeAnimationSegment(context->Segments + context->SegmentIndex, type, (context->PointIndex - 1));
 
+    context->Curves[context->CurveIndex].SegmentCount += 1;
 
-              break;
-            }
-          }
+    // Update context.
+    context->SegmentValueIndex += 1;
+    context->SegmentTypePosition += ((segmentType == BezierSegment)
+      ? 7
+      : 3);
 
+    context->SegmentIndex += 1;
+    context->BezierIndex += (type == csmBezierAnimationSegment);
+  }
 
-          context->Buffer->Segments[context->SegmentIndex].BasePointIndex = (context->PointIndex - 1);
 
-          context->Buffer->Curves[context->CurveIndex].SegmentCount += 1;
+  // Read point data.
+  else
+  {
+    // Read time...
+    if (context->ReadPointTime)
+    {
+      context->Points[context->PointIndex].Time = value;
+    }
 
-          // Update context.
-          context->SegmentValueIndex += 1;
-          context->SegmentTypePosition += ((segmentType == BezierSegment)
-            ? 7
-            : 3);
 
-          context->SegmentIndex += 1;
-        }
+    // ... or value.
+    else
+    {
+      context->Points[context->PointIndex].Value = value;
 
 
-        // Read point data.
-        else
-        {
-          // Read time...
-          if (context->ReadPointTime)
-          {
-            ReadFloatFromString(jsonString + begin, &context->Buffer->Points[context->PointIndex].Time);
-          }
+      // Update context.
+      context->PointIndex += 1;
+    }
 
 
-          // ... or value.
-          else
-          {
-            ReadFloatFromString(jsonString + begin, &context->Buffer->Points[context->PointIndex].Value);
+    // Update context.
+    context->SegmentValueIndex += 1;
 
+    context->ReadPointTime = !context->ReadPointTime;
+  }
+}
 
-            // Update context.
-            context->PointIndex += 1;
-          }
 
+/// Reads a segments array straight from a serialized motion3.json (without lexing it).
+///
+/// @param  jsonString  Serialized motion.
+/// @param  length      Length of serialized motion (in chars).
+/// @param  position    Offset into string behind array begin.
+/// @param  context     Parser context.
+///
+/// @return  Offset into string behind array end (or at first unexpected char).
+static int ReadSegments3(const char* jsonString, const int length, int position, MotionParserContext* context)
+{
+  float value;
+  int next;
 
-          // Update context.
-          context->SegmentValueIndex += 1;
 
-          context->ReadPointTime = !context->ReadPointTime;
-        }
-      }
+  for (;;)
+  {
+    // Skip separators.
+    for (; position < length && (jsonString[position] == ',' || jsonString[position] == ' ' || jsonString[position] == '\t' || jsonString[position] == '\n' || jsonString[position] == '\r'); ++position)
+    {
+      ;
+    }
 
 
-      break;
+    // Stop at array end...
+    if (position >= length || jsonString[position] == ']')
+    {
+      return position + 1;
     }
 
 
-    default:
+    // ... or at anything unexpected.
+    next = ScanFloat(jsonString, position, length, &value);
+
+
+    if (next == position)
     {
-      break;
+      return position;
     }
+
+
+    ReadSegmentValue(context, value);
+
+
+    position = next;
   }
+}
 
 
-  return context->State != FinishedParsing;
+/// Skips a segments array of a serialized motion3.json (without reading it).
+///
+/// @param  jsonString  Serialized motion.
+/// @param  length      Length of serialized motion (in chars).
+/// @param  position    Offset into string behind array begin.
+/// @param  context     [Unused] Parser context.
+///
+/// @return  Offset into string behind array end.
+static int SkipSegments3(const char* jsonString, const int length, int position, MotionParserContext* context)
+{
+  (void)context;
+
+
+  // Segments arrays contain numbers only, so the next bracket closes the array.
+  for (; position < length && jsonString[position] != ']'; ++position)
+  {
+    ;
+  }
+
+
+  return position + 1;
 }
 
 
@@ -790,44 +885,305 @@ static csmJsonTokenHandler MotionParsers[] =
   ParseMotion3
 };
 
+/// Available bulk segment readers.
+static SegmentsReader SegmentsReaders[] =
+{
+  0,
+  0,
+  0,
+  ReadSegments3
+};
+
+/// Available segment skippers.
+static SegmentsReader SegmentsSkippers[] =
+{
+  0,
+  0,
+  0,
+  SkipSegments3
+};
+
 
 // -------------- //
 // IMPLEMENTATION //
 // -------------- //
 
-void ReadMotionJsonMeta(const char* motionJson, MotionJsonMeta* buffer)
+/// Feeds JSON tokens to a handler.
+///
+/// @param  motionJson  Motion JSON string.
+/// @param  length      Length of JSON string (in chars).
+/// @param  tape        [Optional] Token tape to replay instead of lexing.
+/// @param  tokenCount  Number of tokens in tape.
+/// @param  offset      Offset into JSON string to start at (in chars).
+/// @param  onToken     Token handler.
+/// @param  userData    Data to pass to token handler.
+static void LexOrReplayJson(const char* motionJson,
+                            const int length,
+                            const csmJsonToken* tape,
+                            const int tokenCount,
+                            const int offset,
+                            csmJsonTokenHandler onToken,
+                            void* userData)
+{
+  if (tape)
+  {
+    ReplayJsonTapeFrom(motionJson, tape, tokenCount, offset, onToken, userData);
+  }
+  else
+  {
+    LexJsonFrom(motionJson, length, offset, onToken, userData);
+  }
+}
+
+
+/// Reads version of a serialized motion.
+///
+/// @param  motionJson  Motion JSON string.
+/// @param  length      Length of JSON string (in chars).
+/// @param  tape        [Optional] Token tape to replay instead of lexing.
+/// @param  tokenCount  Number of tokens in tape.
+///
+/// @return  Version ('0' if missing).
+static int ReadVersion(const char* motionJson, const int length, const csmJsonToken* tape, const int tokenCount)
+{
+  VersionParserContext context;
+  int version;
+
+
+  version = 0;
+
+
+  InitializeVersionParserContext(&context, &version);
+  LexOrReplayJson(motionJson, length, tape, tokenCount, 0, ParseVersion, &context);
+
+
+  return version;
+}
+
+
+int ReadMotionJsonMeta(const char* motionJson, const int length, const csmJsonToken* tape, const int tokenCount, MotionJsonMeta* buffer)
 {
-  VersionParserContext versionParserContext;
   MetaParserContext context;
   int version;
 
 
   // Get version info.
-  InitializeVersionParserContext(&versionParserContext, &version);
-  csmLexJson(motionJson, ParseVersion, &versionParserContext);
+  version = ReadVersion(motionJson, length, tape, tokenCount);
+
+
+  if (version < 0 || version >= (int)(sizeof(MetaParsers) / sizeof(MetaParsers[0])) || !MetaParsers[version])
+  {
+    return 0;
+  }
 
 
   // Parse meta matching version.
   InitializeMetaParserContext(&context, buffer);
-  csmLexJson(motionJson, MetaParsers[version], &context);
+  LexOrReplayJson(motionJson, length, tape, tokenCount, 0, MetaParsers[version], &context);
+
+
+  buffer->Version = version;
+
+
+  // Derive number of béziers from number of points (as each bezier segment takes 2 points more than others).
+  buffer->TotalBezierCount = (buffer->TotalPointCount - buffer->CurveCount - buffer->TotalSegmentCount) / 2;
+
+
+  return context.State == FinishedParsing
+    && buffer->CurveCount >= 0
+    && buffer->CurveCount <= SHRT_MAX
+    && buffer->TotalSegmentCount >= 0
+    && buffer->TotalPointCount >= 0
+    && buffer->TotalBezierCount >= 0;
 }
 
-void ReadMotionJson(const char* motionJson, csmAnimation* buffer)
+/// Reads a serialized motion, optionally leaving curve segments for later.
+///
+/// @param  motionJson  Motion JSON string.
+/// @param  length      Length of JSON string (in chars).
+/// @param  tape        [Optional] Token tape of JSON string to replay instead of lexing.
+/// @param  tokenCount  Number of tokens in tape.
+/// @param  meta        Meta read from JSON string before.
+/// @param  lazily      Non-zero to only record where segments are.
+/// @param  buffer      Buffer to read into.
+///
+/// @return  Non-zero on success; '0' if motion JSON is invalid.
+static int ReadMotion(const char* motionJson,
+                      const int length,
+                      const csmJsonToken* tape,
+                      const int tokenCount,
+                      const MotionJsonMeta* meta,
+                      const int lazily,
+                      csmAnimation* buffer)
 {
-  VersionParserContext versionParserContext;
+  csmAnimationLazySource* lazySource;
   MotionParserContext context;
-  int version;
+  int position, c;
 
 
-  // Get version info.
-  InitializeVersionParserContext(&versionParserContext, &version);
-  csmLexJson(motionJson, ParseVersion, &versionParserContext);
+  InitializeMotionParserContext(&context, buffer);
 
 
-  // Parse matching version.
-  InitializeMotionParserContext(&context, buffer);
-  csmLexJson(motionJson, MotionParsers[version], &context);
+  // Initialize data fields.
+  buffer->Duration = meta->Duration;
+  buffer->Fps = meta->Fps;
+  buffer->Loop = (short)meta->Loop;
+
+  buffer->CurveCount = (short)meta->CurveCount;
+  buffer->TotalSegmentCount = meta->TotalSegmentCount;
+  buffer->TotalPointCount = meta->TotalPointCount;
+  buffer->TotalBezierCount = meta->TotalBezierCount;
+
+
+  // Initialize offset fields.
+  buffer->CurvesOffset = (int)sizeof(csmAnimation);
+  buffer->SegmentsOffset = buffer->CurvesOffset + (int)(sizeof(csmAnimationCurve) * meta->CurveCount);
+  buffer->PointsOffset = buffer->SegmentsOffset + (int)(sizeof(csmAnimationSegment) * meta->TotalSegmentCount);
+  buffer->BezierPolynomialsOffset = buffer->PointsOffset + (int)(sizeof(csmAnimationPoint) * meta->TotalPointCount);
+  buffer->BezierTimePolynomialsOffset = (meta->AreBeziersRestricted)
+    ? 0
+    : buffer->BezierPolynomialsOffset + (int)(sizeof(csmAnimationBezierPolynomial) * meta->TotalBezierCount);
+  buffer->LazySourceOffset = (lazily)
+    ? AlignLazySourceOffset((buffer->BezierTimePolynomialsOffset)
+      ? (buffer->BezierTimePolynomialsOffset + (int)(sizeof(csmAnimationBezierTimePolynomial) * meta->TotalBezierCount))
+      : (buffer->BezierPolynomialsOffset + (int)(sizeof(csmAnimationBezierPolynomial) * meta->TotalBezierCount)))
+    : 0;
+
+
+  context.Curves = GetAnimationCurves(buffer);
+  context.Segments = GetAnimationSegments(buffer);
+  context.Points = GetAnimationPoints(buffer);
+  context.SegmentsPositions = GetAnimationLazySegmentsPositions(buffer);
+
+
+  // Parse matching version (reading or skipping segments in bulk whenever parser stops at them).
+  for (position = 0; ; )
+  {
+    LexOrReplayJson(motionJson, length, tape, tokenCount, position, MotionParsers[meta->Version], &context);
+
+
+    if (context.State != ReadingSegmentsInBulk)
+    {
+      break;
+    }
+
+
+    if (context.SegmentsPositions)
+    {
+      context.SegmentsPositions[context.CurveIndex] = context.BulkPosition;
+
+
+      position = SegmentsSkippers[meta->Version](motionJson, length, context.BulkPosition, &context);
+    }
+    else
+    {
+      position = SegmentsReaders[meta->Version](motionJson, length, context.BulkPosition, &context);
+    }
+
+
+    context.State = ReadingCurve;
+  }
+
+
+  // Fail on incomplete curves.
+  if (context.State != FinishedParsing)
+  {
+    return 0;
+  }
+
+
+  // Remember source for decoding curves on demand...
+  if (lazily)
+  {
+    lazySource = GetAnimationLazySource(buffer);
+
+
+    lazySource->MotionJson = motionJson;
+    lazySource->Length = length;
+    lazySource->Version = meta->Version;
+    lazySource->NextSegmentIndex = 0;
+    lazySource->NextPointIndex = 0;
+    lazySource->NextBezierIndex = 0;
+    lazySource->UndecodedCurveCount = buffer->CurveCount;
+
+
+    // ... and flag curves as not decoded yet.
+    for (c = 0; c < buffer->CurveCount; ++c)
+    {
+      context.Curves[c].SegmentCount = -1;
+      context.Curves[c].StaticTime = FLT_MAX;
+      context.Curves[c].StaticValue = 0.0f;
+    }
+
+
+    return 1;
+  }
+
+
+  // Convert béziers for evaluation (picking unrestricted evaluation only if necessary).
+  InitializeAnimationBezierPolynomials(buffer);
+
+
+  // Find curves that needn't be evaluated.
+  InitializeAnimationStaticCurves(buffer);
+
+
+  return 1;
+}
+
+
+int ReadMotionJson(const char* motionJson,
+                   const int length,
+                   const csmJsonToken* tape,
+                   const int tokenCount,
+                   const MotionJsonMeta* meta,
+                   csmAnimation* buffer)
+{
+  return ReadMotion(motionJson, length, tape, tokenCount, meta, 0, buffer);
+}
+
+int ReadMotionJsonLazily(const char* motionJson, const int length, const MotionJsonMeta* meta, csmAnimation* buffer)
+{
+  return ReadMotion(motionJson, length, 0, 0, meta, 1, buffer);
+}
+
+void ReadLazyMotionJsonCurve(csmAnimation* animation, const int index)
+{
+  csmAnimationLazySource* lazySource;
+  MotionParserContext context;
+
+
+  lazySource = GetAnimationLazySource(animation);
+
+
+  // Place curve behind curves decoded so far.
+  InitializeMotionParserContext(&context, animation);
+
+
+  context.Curves = GetAnimationCurves(animation);
+  context.Segments = GetAnimationSegments(animation);
+  context.Points = GetAnimationPoints(animation);
+
+  context.CurveIndex = index;
+  context.SegmentIndex = lazySource->NextSegmentIndex;
+  context.PointIndex = lazySource->NextPointIndex;
+  context.BezierIndex = lazySource->NextBezierIndex;
+  context.SegmentTypePosition = 2;
+  context.ReadPointTime = 1;
+
+
+  context.Curves[index].BaseSegmentIndex = context.SegmentIndex;
+  context.Curves[index].BaseBezierIndex = context.BezierIndex;
+  context.Curves[index].SegmentCount = 0;
+
+
+  SegmentsReaders[lazySource->Version](lazySource->MotionJson,
+                                       lazySource->Length,
+                                       GetAnimationLazySegmentsPositions(animation)[index],
+                                       &context);
 
 
-  // TODO Log warning in case curves aren't restricted.
+  lazySource->NextSegmentIndex = context.SegmentIndex;
+  lazySource->NextPointIndex = context.PointIndex;
+  lazySource->NextBezierIndex = context.BezierIndex;
 }
@@ -1,7 +1,9 @@
 #include <Live2DCubismFramework.h>
 #include <Live2DCubismFrameworkINTERNAL.h>
 
+#include <limits.h>
 #include <math.h>
+#include <string.h>
 
 // -------- //
 // REQUIRES //
@@ -22,6 +24,16 @@ const float MaximumWeight = 100.0f;
 const float MovementThreshold = 0.001f;
 
 
+/// Magic bytes of serialized physics.
+static const char BlobMagic[4] = { 'C', 'P', 'H', 'Y' };
+
+/// Version of serialized physics.
+static const unsigned int BlobVersion = 1;
+
+/// Byte order mark of serialized physics.
+static const unsigned int BlobByteOrderMark = 0x01020304;
+
+
 // TODO Document
 static void Initialize(csmPhysicsRig* physics)
 {
@@ -38,6 +50,7 @@ static void Initialize(csmPhysicsRig* physics)
 
     // Initialize the top of particle.
     strand[0].InitialPosition = MakeVector2(0.0f, 0.0f);
+    strand[0].Position = strand[0].InitialPosition;
     strand[0].LastPosition = strand[0].InitialPosition;
     strand[0].LastGravity = MakeVector2(0.0f, -1.0f);
     strand[0].LastGravity.Y *= -1.0f;
@@ -201,37 +214,528 @@ static void UpdateParticles(
   }
 }
 
+/// Computes the deserialized size of physics.
+///
+/// @param  meta  Meta of serialized physics.
+///
+/// @return  Number of bytes necessary.
+static unsigned int GetDeserializedSizeofPhysics(const PhysicsJsonMeta* meta)
+{
+  return sizeof(csmPhysicsRig) +
+    (sizeof(csmPhysicsSubRig) * meta->SubRigCount) +
+    (sizeof(csmPhysicsInput) * meta->TotalInputCount) +
+    (sizeof(csmPhysicsOutput) * meta->TotalOutputCount) +
+    (sizeof(csmPhysicsParticle) * meta->ParticleCount);
+}
+
+/// Computes the serialized size of physics.
+///
+/// @param  meta  Meta of physics.
+///
+/// @return  Number of bytes necessary.
+static unsigned long long GetSerializedSizeofPhysics(const PhysicsJsonMeta* meta)
+{
+  return sizeof(csmPhysicsBlobHeader) +
+    (sizeof(csmPhysicsSubRig) * (unsigned long long)meta->SubRigCount) +
+    (sizeof(csmSerializedPhysicsInput) * (unsigned long long)meta->TotalInputCount) +
+    (sizeof(csmSerializedPhysicsOutput) * (unsigned long long)meta->TotalOutputCount) +
+    (sizeof(csmSerializedPhysicsParticle) * (unsigned long long)meta->ParticleCount);
+}
+
+/// Gathers the meta of deserialized physics.
+///
+/// @param  physics  Physics to query.
+/// @param  buffer   Buffer to write to.
+static void GetPhysicsMeta(const csmPhysicsRig* physics, PhysicsJsonMeta* buffer)
+{
+  const csmPhysicsSubRig* subRig;
+  int s;
+
+
+  buffer->SubRigCount = physics->SubRigCount;
+  buffer->TotalInputCount = 0;
+  buffer->TotalOutputCount = 0;
+  buffer->ParticleCount = 0;
+  buffer->EffectiveForces.Gravity = physics->Gravity;
+  buffer->EffectiveForces.Wind = physics->Wind;
+
+
+  // Derive totals from sub rigs as rigs don't store them.
+  for (s = 0; s < physics->SubRigCount; ++s)
+  {
+    subRig = &physics->Settings[s];
+
+
+    if ((subRig->BaseInputIndex + subRig->InputCount) > buffer->TotalInputCount)
+    {
+      buffer->TotalInputCount = subRig->BaseInputIndex + subRig->InputCount;
+    }
+
+    if ((subRig->BaseOutputIndex + subRig->OutputCount) > buffer->TotalOutputCount)
+    {
+      buffer->TotalOutputCount = subRig->BaseOutputIndex + subRig->OutputCount;
+    }
+
+    if ((subRig->BaseParticleIndex + subRig->ParticleCount) > buffer->ParticleCount)
+    {
+      buffer->ParticleCount = subRig->BaseParticleIndex + subRig->ParticleCount;
+    }
+  }
+}
+
+/// Checks whether a range of a sub rig lies within its array.
+///
+/// @param  base   First index of range.
+/// @param  count  Number of elements in range.
+/// @param  total  Number of elements in array.
+///
+/// @return  Non-zero if range is valid; '0' otherwise.
+static int IsRangeInArray(const int base, const int count, const int total)
+{
+  return base >= 0 && count >= 0 && base <= total && count <= (total - base);
+}
+
+/// Validates the header of a serialized physics blob.
+///
+/// @param  blob  Blob to validate.
+/// @param  size  Size of blob (in bytes).
+/// @param  meta  Buffer to write meta of serialized physics to.
+///
+/// @return  Header on success; '0' otherwise.
+static const csmPhysicsBlobHeader* GetPhysicsBlobHeader(const void* blob, const unsigned int size, PhysicsJsonMeta* meta)
+{
+  const csmPhysicsBlobHeader* header;
+
+
+  // Validate arguments.
+  Ensure(blob, "\"blob\" is invalid.", return 0);
+  Ensure(((size_t)blob % sizeof(int)) == 0, "\"blob\" is misaligned.", return 0);
+  Ensure((size >= sizeof(csmPhysicsBlobHeader)), "\"size\" is too small.", return 0);
+
+
+  header = (const csmPhysicsBlobHeader*)blob;
+
+
+  Ensure(memcmp(header->Magic, BlobMagic, sizeof(BlobMagic)) == 0, "Blob isn't physics.", return 0);
+  Ensure((header->Version == BlobVersion), "Physics blob version is unsupported.", return 0);
+  Ensure((header->ByteOrderMark == BlobByteOrderMark), "Physics blob byte order doesn't match.", return 0);
+  Ensure((header->Size <= size), "Physics blob is truncated.", return 0);
+  Ensure((header->SubRigCount >= 0
+           && header->TotalInputCount >= 0
+           && header->TotalOutputCount >= 0
+           && header->ParticleCount >= 0),
+         "Physics blob is corrupted.",
+         return 0);
+
+
+  // Validate sizes.
+  meta->SubRigCount = header->SubRigCount;
+  meta->TotalInputCount = header->TotalInputCount;
+  meta->TotalOutputCount = header->TotalOutputCount;
+  meta->ParticleCount = header->ParticleCount;
+  meta->EffectiveForces.Gravity = header->Gravity;
+  meta->EffectiveForces.Wind = header->Wind;
+
+
+  Ensure((GetSerializedSizeofPhysics(meta) == header->Size), "Physics blob is corrupted.", return 0);
+  Ensure(((sizeof(csmPhysicsRig)
+            + (sizeof(csmPhysicsSubRig) * (unsigned long long)meta->SubRigCount)
+            + (sizeof(csmPhysicsInput) * (unsigned long long)meta->TotalInputCount)
+            + (sizeof(csmPhysicsOutput) * (unsigned long long)meta->TotalOutputCount)
+            + (sizeof(csmPhysicsParticle) * (unsigned long long)meta->ParticleCount)) <= UINT_MAX),
+         "Physics blob is too big to load.",
+         return 0);
+
+
+  return header;
+}
+
+
 // TODO Document
 unsigned int csmGetDeserializedSizeofPhysics(const char *physicsJson)
+{
+  // Validate argument.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+
+
+  return csmGetDeserializedSizeofPhysicsWithLength(physicsJson, (unsigned int)strlen(physicsJson));
+}
+
+unsigned int csmGetDeserializedSizeofPhysicsWithLength(const char* physicsJson, const unsigned int length)
 {
   PhysicsJsonMeta meta;
 
-  ReadPhysicsJsonMeta(physicsJson, &meta);
 
-  return sizeof(csmPhysicsRig) +
-    (sizeof(csmPhysicsSubRig) * meta.SubRigCount) +
-    (sizeof(csmPhysicsInput) * meta.TotalInputCount) +
-    (sizeof(csmPhysicsOutput) * meta.TotalOutputCount) +
-    (sizeof(csmPhysicsParticle) * meta.ParticleCount);
+  // Validate arguments.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+
+
+  ReadPhysicsJsonMeta(physicsJson, (int)length, 0, 0, &meta);
+
+  return GetDeserializedSizeofPhysics(&meta);
 }
 
 // TODO Document
 csmPhysicsRig* csmDeserializePhysicsInPlace(const char *physicsJson, void* address, const unsigned int size)
+{
+  // Validate argument.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+
+
+  return csmDeserializePhysicsInPlaceWithLength(physicsJson, (unsigned int)strlen(physicsJson), address, size);
+}
+
+csmPhysicsRig* csmDeserializePhysicsInPlaceWithLength(const char* physicsJson,
+                                                      const unsigned int length,
+                                                      void* address,
+                                                      const unsigned int size)
 {
   csmPhysicsRig* physics;
 
 
+  // Validate arguments.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+
+
   // 'Patch' pointer.
   physics = (csmPhysicsRig*)address;
 
 
-  ReadPhysicsJson(physicsJson, physics);
+  ReadPhysicsJson(physicsJson, (int)length, 0, 0, physics);
 
   Initialize(physics);
 
   return physics;
 }
 
+csmPhysicsRig* csmDeserializePhysics(const char* physicsJson,
+                                     csmAllocateFunction allocate,
+                                     csmDeallocateFunction deallocate)
+{
+  // Validate argument.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+
+
+  return csmDeserializePhysicsWithLength(physicsJson, (unsigned int)strlen(physicsJson), allocate, deallocate);
+}
+
+csmPhysicsRig* csmDeserializePhysicsWithLength(const char* physicsJson,
+                                               const unsigned int length,
+                                               csmAllocateFunction allocate,
+                                               csmDeallocateFunction deallocate)
+{
+  csmPhysicsRig* physics;
+  csmJsonToken* tape;
+  PhysicsJsonMeta meta;
+  int tokenCount;
+
+
+  // Validate arguments.
+  Ensure(physicsJson, "\"physicsJson\" is invalid.", return 0);
+  Ensure(length <= INT_MAX, "\"length\" is too big.", return 0);
+  Ensure(allocate, "\"allocate\" is invalid.", return 0);
+  Ensure(deallocate, "\"deallocate\" is invalid.", return 0);
+
+
+  // Lex once...
+  tape = LexJsonIntoAllocatedTape(physicsJson, (int)length, allocate, deallocate, &tokenCount);
+
+
+  if (!tape)
+  {
+    return 0;
+  }
+
+
+  // ... and replay tape for sizing and reading.
+  ReadPhysicsJsonMeta(physicsJson, (int)length, tape, tokenCount, &meta);
+
+
+  physics = allocate(GetDeserializedSizeofPhysics(&meta));
+
+
+  if (physics)
+  {
+    ReadPhysicsJson(physicsJson, (int)length, tape, tokenCount, physics);
+
+    Initialize(physics);
+  }
+  else
+  {
+    Log("[Live2D Cubism Components] Failed to allocate physics.");
+  }
+
+
+  deallocate(tape);
+
+
+  return physics;
+}
+
+unsigned int csmGetSerializedSizeofPhysics(const csmPhysicsRig* physics)
+{
+  PhysicsJsonMeta meta;
+  unsigned long long size;
+
+
+  // Validate argument.
+  Ensure(physics, "\"physics\" is invalid.", return 0);
+
+
+  GetPhysicsMeta(physics, &meta);
+
+
+  size = GetSerializedSizeofPhysics(&meta);
+
+
+  Ensure((size <= UINT_MAX), "Physics are too big to serialize.", return 0);
+
+
+  return (unsigned int)size;
+}
+
+unsigned int csmSerializePhysics(const csmPhysicsRig* physics, void* address, const unsigned int size)
+{
+  csmPhysicsBlobHeader* header;
+  csmPhysicsSubRig* subRigs;
+  csmSerializedPhysicsInput* inputs;
+  csmSerializedPhysicsOutput* outputs;
+  csmSerializedPhysicsParticle* particles;
+  PhysicsJsonMeta meta;
+  unsigned int blobSize;
+  int i;
+
+
+  // Validate arguments.
+  Ensure(physics, "\"physics\" is invalid.", return 0);
+  Ensure(address, "\"address\" is invalid.", return 0);
+
+
+  blobSize = csmGetSerializedSizeofPhysics(physics);
+
+
+  Ensure(blobSize, "Failed to serialize physics.", return 0);
+  Ensure((size >= blobSize), "\"size\" is too small.", return 0);
+
+
+  GetPhysicsMeta(physics, &meta);
+
+
+  // Write header.
+  header = (csmPhysicsBlobHeader*)address;
+
+
+  memcpy(header->Magic, BlobMagic, sizeof(BlobMagic));
+
+  header->Version = BlobVersion;
+  header->ByteOrderMark = BlobByteOrderMark;
+  header->Size = blobSize;
+
+  header->SubRigCount = meta.SubRigCount;
+  header->TotalInputCount = meta.TotalInputCount;
+  header->TotalOutputCount = meta.TotalOutputCount;
+  header->ParticleCount = meta.ParticleCount;
+
+  header->Gravity = physics->Gravity;
+  header->Wind = physics->Wind;
+
+
+  // Write sub rigs as is...
+  subRigs = (csmPhysicsSubRig*)(header + 1);
+
+
+  memcpy(subRigs, physics->Settings, sizeof(csmPhysicsSubRig) * meta.SubRigCount);
+
+
+  // ... inputs and outputs without function pointers and runtime state...
+  inputs = (csmSerializedPhysicsInput*)(subRigs + meta.SubRigCount);
+
+
+  for (i = 0; i < meta.TotalInputCount; ++i)
+  {
+    inputs[i].Source = physics->Inputs[i].Source;
+    inputs[i].Weight = physics->Inputs[i].Weight;
+    inputs[i].Type = physics->Inputs[i].Type;
+    inputs[i].Reflect = physics->Inputs[i].Reflect;
+  }
+
+
+  outputs = (csmSerializedPhysicsOutput*)(inputs + meta.TotalInputCount);
+
+
+  for (i = 0; i < meta.TotalOutputCount; ++i)
+  {
+    outputs[i].Destination = physics->Outputs[i].Destination;
+    outputs[i].VertexIndex = physics->Outputs[i].VertexIndex;
+    outputs[i].TranslationScale = physics->Outputs[i].TranslationScale;
+    outputs[i].AngleScale = physics->Outputs[i].AngleScale;
+    outputs[i].Weight = physics->Outputs[i].Weight;
+    outputs[i].Type = physics->Outputs[i].Type;
+    outputs[i].Reflect = physics->Outputs[i].Reflect;
+  }
+
+
+  // ... and particles at rest.
+  particles = (csmSerializedPhysicsParticle*)(outputs + meta.TotalOutputCount);
+
+
+  for (i = 0; i < meta.ParticleCount; ++i)
+  {
+    particles[i].InitialPosition = physics->Particles[i].InitialPosition;
+    particles[i].Mobility = physics->Particles[i].Mobility;
+    particles[i].Delay = physics->Particles[i].Delay;
+    particles[i].Acceleration = physics->Particles[i].Acceleration;
+    particles[i].Radius = physics->Particles[i].Radius;
+  }
+
+
+  return blobSize;
+}
+
+unsigned int csmGetDeserializedSizeofPhysicsFromBlob(const void* blob, const unsigned int size)
+{
+  const csmPhysicsBlobHeader* header;
+  PhysicsJsonMeta meta;
+
+
+  header = GetPhysicsBlobHeader(blob, size, &meta);
+
+
+  if (!header)
+  {
+    return 0;
+  }
+
+
+  return GetDeserializedSizeofPhysics(&meta);
+}
+
+csmPhysicsRig* csmLoadPhysicsFromBlobInPlace(const void* blob, const unsigned int blobSize, void* address, const unsigned int size)
+{
+  const csmPhysicsBlobHeader* header;
+  const csmPhysicsSubRig* subRigs;
+  const csmSerializedPhysicsInput* inputs;
+  const csmSerializedPhysicsOutput* outputs;
+  const csmSerializedPhysicsParticle* particles;
+  csmPhysicsRig* physics;
+  PhysicsJsonMeta meta;
+  int i;
+
+
+  // Validate arguments.
+  Ensure(address, "\"address\" is invalid.", return 0);
+
+
+  header = GetPhysicsBlobHeader(blob, blobSize, &meta);
+
+
+  if (!header)
+  {
+    return 0;
+  }
+
+
+  Ensure((size >= GetDeserializedSizeofPhysics(&meta)), "\"size\" is too small.", return 0);
+
+
+  // Initialize rig with same layout as deserialized physics.
+  physics = (csmPhysicsRig*)address;
+
+
+  physics->SubRigCount = header->SubRigCount;
+  physics->Gravity = header->Gravity;
+  physics->Wind = header->Wind;
+
+  physics->Settings = (csmPhysicsSubRig*)(physics + 1);
+  physics->Inputs = (csmPhysicsInput*)(physics->Settings + header->SubRigCount);
+  physics->Outputs = (csmPhysicsOutput*)(physics->Inputs + header->TotalInputCount);
+  physics->Particles = (csmPhysicsParticle*)(physics->Outputs + header->TotalOutputCount);
+
+
+  // Copy blob in a single linear pass, validating what evaluation relies on along the way.
+  subRigs = (const csmPhysicsSubRig*)(header + 1);
+
+
+  for (i = 0; i < header->SubRigCount; ++i)
+  {
+    Ensure((IsRangeInArray(subRigs[i].BaseInputIndex, subRigs[i].InputCount, header->TotalInputCount)
+             && IsRangeInArray(subRigs[i].BaseOutputIndex, subRigs[i].OutputCount, header->TotalOutputCount)
+             && IsRangeInArray(subRigs[i].BaseParticleIndex, subRigs[i].ParticleCount, header->ParticleCount)
+             && subRigs[i].ParticleCount > 0),
+           "Physics blob is corrupted.",
+           return 0);
+
+
+    physics->Settings[i] = subRigs[i];
+  }
+
+
+  inputs = (const csmSerializedPhysicsInput*)(subRigs + header->SubRigCount);
+
+
+  for (i = 0; i < header->TotalInputCount; ++i)
+  {
+    Ensure((inputs[i].Type >= 0 && inputs[i].Type < csmPhysicsSourceTypeCount), "Physics blob is corrupted.", return 0);
+
+
+    physics->Inputs[i].Source = inputs[i].Source;
+    physics->Inputs[i].SourceParameterIndex = -1;
+    physics->Inputs[i].Weight = inputs[i].Weight;
+    physics->Inputs[i].Type = inputs[i].Type;
+    physics->Inputs[i].Reflect = inputs[i].Reflect;
+
+    BindPhysicsInput(&physics->Inputs[i]);
+  }
+
+
+  outputs = (const csmSerializedPhysicsOutput*)(inputs + header->TotalInputCount);
+
+
+  for (i = 0; i < header->TotalOutputCount; ++i)
+  {
+    Ensure((outputs[i].Type >= 0 && outputs[i].Type < csmPhysicsSourceTypeCount), "Physics blob is corrupted.", return 0);
+
+
+    physics->Outputs[i].Destination = outputs[i].Destination;
+    physics->Outputs[i].DestinationParameterIndex = -1;
+    physics->Outputs[i].VertexIndex = outputs[i].VertexIndex;
+    physics->Outputs[i].TranslationScale = outputs[i].TranslationScale;
+    physics->Outputs[i].AngleScale = outputs[i].AngleScale;
+    physics->Outputs[i].Weight = outputs[i].Weight;
+    physics->Outputs[i].Type = outputs[i].Type;
+    physics->Outputs[i].Reflect = outputs[i].Reflect;
+    physics->Outputs[i].ValueBelowMinimum = 0.0f;
+    physics->Outputs[i].ValueExceededMaximum = 0.0f;
+
+    BindPhysicsOutput(&physics->Outputs[i]);
+  }
+
+
+  // Rest positions are stored, so particles don't have to be initialized strand by strand.
+  particles = (const csmSerializedPhysicsParticle*)(outputs + header->TotalOutputCount);
+
+
+  for (i = 0; i < header->ParticleCount; ++i)
+  {
+    physics->Particles[i].InitialPosition = particles[i].InitialPosition;
+    physics->Particles[i].Mobility = particles[i].Mobility;
+    physics->Particles[i].Delay = particles[i].Delay;
+    physics->Particles[i].Acceleration = particles[i].Acceleration;
+    physics->Particles[i].Radius = particles[i].Radius;
+    physics->Particles[i].Position = particles[i].InitialPosition;
+    physics->Particles[i].LastPosition = particles[i].InitialPosition;
+    physics->Particles[i].LastGravity = MakeVector2(0.0f, 1.0f);
+    physics->Particles[i].Force = MakeVector2(0.0f, 0.0f);
+    physics->Particles[i].Velocity = MakeVector2(0.0f, 0.0f);
+  }
+
+
+  return physics;
+}
+
+
 // TODO Document
 void csmPhysicsEvaluate(csmModel* model, csmPhysicsRig* physics, csmPhysicsOptions* options, float deltaTime)
 {
@@ -400,6 +400,31 @@ static float GetOutputScaleAngle(csmVector2 translationScale, float angleScale)
   return angleScale;
 }
 
+
+/// Input getters by source type.
+static const NormalizedPhysicsParameterValueGetter NormalizedParameterValueGetters[csmPhysicsSourceTypeCount] =
+{
+  GetInputTranslationXFromNormalizedParameterValue,
+  GetInputTranslationYFromNormalizedParameterValue,
+  GetInputAngleFromNormalizedParameterValue
+};
+
+/// Output value getters by source type.
+static const PhysicsValueGetter ValueGetters[csmPhysicsSourceTypeCount] =
+{
+  GetOutputTranslationX,
+  GetOutputTranslationY,
+  GetOutputAngle
+};
+
+/// Output scale getters by source type.
+static const PhysicsScaleGetter ScaleGetters[csmPhysicsSourceTypeCount] =
+{
+  GetOutputScaleTranslationX,
+  GetOutputScaleTranslationY,
+  GetOutputScaleAngle
+};
+
 // --------------------------- //
 // VERSION INDEPENDENT PARSERS //
 // --------------------------- //
@@ -444,7 +469,7 @@ static int ParseVersion(const char* jsonString, csmJsonTokenType type, int begin
       }
 
 
-      else if (DoesStringStartWith(jsonString + begin, "Version"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Version"))
       {
         context->State = ReadingVersion;
       }
@@ -457,7 +482,7 @@ static int ParseVersion(const char* jsonString, csmJsonTokenType type, int begin
     // ... then read version.
     case ReadingVersion:
     {
-      ReadIntFromString(jsonString + begin, context->Buffer);
+      ReadIntFromSubString(jsonString, begin, end, context->Buffer);
 
 
       context->State = FinishedParsing;
@@ -499,10 +524,6 @@ static void InitializePhysicsParserContext(PhysicsParserContext* context, csmPhy
   context->OutputIndex = 0;
   context->SettingIndex = 0;
   context->VertexIndex = 0;
-
-
-  // 'Flag' buffer as uninitialized...
-  context->Buffer->Settings = 0;
 }
 
 
@@ -540,7 +561,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       }
 
 
-      else if (DoesStringStartWith(jsonString + begin, "Meta"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Meta"))
       {
         context->State = Waiting;
       }
@@ -563,23 +584,23 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       // Select data to read.
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "PhysicsSettingCount"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "PhysicsSettingCount"))
         {
           context->State = ReadingPhysicsSettingCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "TotalInputCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "TotalInputCount"))
         {
           context->State = ReadingTotalInputCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "TotalOutputCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "TotalOutputCount"))
         {
           context->State = ReadingTotalOutputCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "VertexCount"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "VertexCount"))
         {
           context->State = ReadingVertexCount;
         }
-        else if (DoesStringStartWith(jsonString + begin, "EffectiveForces"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "EffectiveForces"))
         {
           context->State = ReadingEffectiveForces;
         }
@@ -593,7 +614,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingPhysicsSettingCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->SubRigCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->SubRigCount);
 
 
       context->State = Waiting;
@@ -606,7 +627,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingTotalInputCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->TotalInputCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->TotalInputCount);
 
 
       context->State = Waiting;
@@ -619,7 +640,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingTotalOutputCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->TotalOutputCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->TotalOutputCount);
 
 
       context->State = Waiting;
@@ -632,7 +653,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingVertexCount:
     {
-      ReadIntFromString(jsonString + begin, &context->Buffer->ParticleCount);
+      ReadIntFromSubString(jsonString, begin, end, &context->Buffer->ParticleCount);
 
 
       context->State = Waiting;
@@ -651,11 +672,11 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       }
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "Gravity"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "Gravity"))
         {
           context->State = ReadingEffectiveForcesGravity;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Wind"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Wind"))
         {
           context->State = ReadingEffectiveForcesWind;
         }
@@ -675,11 +696,11 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       }
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "X"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "X"))
         {
           context->State = ReadingEffectiveForcesGravityX;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Y"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Y"))
         {
           context->State = ReadingEffectiveForcesGravityY;
         }
@@ -693,7 +714,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingEffectiveForcesGravityX:
     {
-      ReadFloatFromString(jsonString + begin, &context->Buffer->EffectiveForces.Gravity.X);
+      ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->EffectiveForces.Gravity.X);
 
 
       context->State = ReadingEffectiveForcesGravity;
@@ -706,7 +727,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingEffectiveForcesGravityY:
     {
-      ReadFloatFromString(jsonString + begin, &context->Buffer->EffectiveForces.Gravity.Y);
+      ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->EffectiveForces.Gravity.Y);
 
 
       context->State = ReadingEffectiveForcesGravity;
@@ -725,11 +746,11 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
       }
       else
       {
-        if (DoesStringStartWith(jsonString + begin, "X"))
+        if (DoesSubStringStartWith(jsonString, begin, end, "X"))
         {
           context->State = ReadingEffectiveForcesWindX;
         }
-        else if (DoesStringStartWith(jsonString + begin, "Y"))
+        else if (DoesSubStringStartWith(jsonString, begin, end, "Y"))
         {
           context->State = ReadingEffectiveForcesWindY;
         }
@@ -743,7 +764,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingEffectiveForcesWindX:
     {
-      ReadFloatFromString(jsonString + begin, &context->Buffer->EffectiveForces.Wind.X);
+      ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->EffectiveForces.Wind.X);
 
 
       context->State = ReadingEffectiveForcesWind;
@@ -756,7 +777,7 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
     // TODO Document
     case ReadingEffectiveForcesWindY:
     {
-      ReadFloatFromString(jsonString + begin, &context->Buffer->EffectiveForces.Wind.Y);
+      ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->EffectiveForces.Wind.Y);
 
 
       context->State = ReadingEffectiveForcesWind;
@@ -779,38 +800,13 @@ static int ParseMeta3(const char* jsonString, csmJsonTokenType type, int begin,
 
 static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begin, int end, void* physicsParserContext)
 {
-  MetaParserContext metaParserContext;
   PhysicsParserContext* context;
-  int segmentType;
 
 
   // Recover context.
   context = physicsParserContext;
 
 
-  // Initialize meta related fields if necessary.
-  if (!context->Buffer->Settings)
-  {
-    // Parse meta.
-    InitializeMetaParserContext(&metaParserContext, &context->Meta);
-    csmLexJson(jsonString, ParseMeta3, &metaParserContext);
-
-
-    // Initialize data fields.
-    context->Buffer->Gravity = context->Meta.EffectiveForces.Gravity;
-
-    context->Buffer->Wind = context->Meta.EffectiveForces.Wind;
-
-    context->Buffer->SubRigCount = context->Meta.SubRigCount;
-
-
-    // Initialize pointer fields.
-    context->Buffer->Settings = (csmPhysicsSubRig*)(context->Buffer + 1);
-    context->Buffer->Inputs = (csmPhysicsInput*)(context->Buffer->Settings + context->Meta.SubRigCount);
-    context->Buffer->Outputs = (csmPhysicsOutput*)(context->Buffer->Inputs + context->Meta.TotalInputCount);
-    context->Buffer->Particles = (csmPhysicsParticle*)(context->Buffer->Outputs + context->Meta.TotalOutputCount);
-  }
-
   // Handle token.
   switch (context->State)
   {
@@ -824,7 +820,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
 
 
-    else if (DoesStringStartWith(jsonString + begin, "PhysicsSettings"))
+    else if (DoesSubStringStartWith(jsonString, begin, end, "PhysicsSettings"))
     {
       context->State = Waiting;
     }
@@ -884,19 +880,19 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     // Prepare context for reading setting data.
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Input"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Input"))
       {
         context->State = ReadingInput;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Output"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Output"))
       {
         context->State = ReadingOutput;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Vertices"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Vertices"))
       {
         context->State = ReadingVertices;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Normalization"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Normalization"))
       {
         context->State = ReadingNormalization;
       }
@@ -920,19 +916,19 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Source"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Source"))
       {
         context->State = ReadingInputSource;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Weight"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Weight"))
       {
         context->State = ReadingInputWeight;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Type"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Type"))
       {
         context->State = ReadingInputType;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Reflect"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Reflect"))
       {
         context->State = ReadingInputReflect;
       }
@@ -952,11 +948,11 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Target"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Target"))
       {
         context->State = ReadingInputSourceTarget;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Id"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Id"))
       {
         context->State = ReadingInputSourceId;
       }
@@ -983,7 +979,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingInputSourceTarget:
   {
-    if (DoesStringStartWith(jsonString + begin, "Parameter"))
+    if (DoesSubStringStartWith(jsonString, begin, end, "Parameter"))
     {
       context->Buffer->Inputs[context->InputIndex].Source.TargetType = csmParameterPhysics;
     }
@@ -999,7 +995,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingInputWeight:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Inputs[context->InputIndex].Weight);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Inputs[context->InputIndex].Weight);
 
 
     context->State = ReadingInput;
@@ -1012,20 +1008,20 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingInputType:
   {
-    if (DoesStringStartWith(jsonString + begin, "X"))
+    if (DoesSubStringStartWith(jsonString, begin, end, "X"))
     {
       context->Buffer->Inputs[context->InputIndex].Type = csmSourceXPhysics;
-      context->Buffer->Inputs[context->InputIndex].GetNormalizedParameterValue = GetInputTranslationXFromNormalizedParameterValue;
+      BindPhysicsInput(&context->Buffer->Inputs[context->InputIndex]);
     }
-    else if (DoesStringStartWith(jsonString + begin, "Y"))
+    else if (DoesSubStringStartWith(jsonString, begin, end, "Y"))
     {
       context->Buffer->Inputs[context->InputIndex].Type = csmSourceYPhysics;
-      context->Buffer->Inputs[context->InputIndex].GetNormalizedParameterValue = GetInputTranslationYFromNormalizedParameterValue;
+      BindPhysicsInput(&context->Buffer->Inputs[context->InputIndex]);
     }
-    else if (DoesStringStartWith(jsonString + begin, "Angle"))
+    else if (DoesSubStringStartWith(jsonString, begin, end, "Angle"))
     {
       context->Buffer->Inputs[context->InputIndex].Type = csmSourceAnglePhysics;
-      context->Buffer->Inputs[context->InputIndex].GetNormalizedParameterValue = GetInputAngleFromNormalizedParameterValue;
+      BindPhysicsInput(&context->Buffer->Inputs[context->InputIndex]);
     }
 
     context->State = ReadingInput;
@@ -1061,27 +1057,27 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Destination"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Destination"))
       {
         context->State = ReadingOutputDestination;
       }
-      else if (DoesStringStartWith(jsonString + begin, "VertexIndex"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "VertexIndex"))
       {
         context->State = ReadingOutputVertexIndex;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Scale"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Scale"))
       {
         context->State = ReadingOutputScale;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Weight"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Weight"))
       {
         context->State = ReadingOutputWeight;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Type"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Type"))
       {
         context->State = ReadingOutputType;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Reflect"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Reflect"))
       {
         context->State = ReadingOutputReflect;
       }
@@ -1101,11 +1097,11 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Target"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Target"))
       {
         context->State = ReadingOutputDestinationTarget;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Id"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Id"))
       {
         context->State = ReadingOutputDestinationId;
       }
@@ -1132,7 +1128,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingOutputDestinationTarget:
   {
-    if (DoesStringStartWith(jsonString + begin, "Parameter"))
+    if (DoesSubStringStartWith(jsonString, begin, end, "Parameter"))
     {
       context->Buffer->Outputs[context->OutputIndex].Destination.TargetType = csmParameterPhysics;
     }
@@ -1148,7 +1144,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingOutputVertexIndex:
   {
-    ReadIntFromString(jsonString + begin, &context->Buffer->Outputs[context->OutputIndex].VertexIndex);
+    ReadIntFromSubString(jsonString, begin, end, &context->Buffer->Outputs[context->OutputIndex].VertexIndex);
 
 
     context->State = ReadingOutput;
@@ -1162,7 +1158,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   case ReadingOutputScale:
   {
     context->Buffer->Outputs[context->OutputIndex].TranslationScale = MakeVector2(0.0f, 0.0f);
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Outputs[context->OutputIndex].AngleScale);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Outputs[context->OutputIndex].AngleScale);
 
 
     context->State = ReadingOutput;
@@ -1175,7 +1171,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingOutputWeight:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Outputs[context->OutputIndex].Weight);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Outputs[context->OutputIndex].Weight);
 
 
     context->State = ReadingOutput;
@@ -1188,23 +1184,20 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingOutputType:
   {
-    if (DoesStringStartWith(jsonString + begin, "X"))
+    if (DoesSubStringStartWith(jsonString, begin, end, "X"))
     {
       context->Buffer->Outputs[context->OutputIndex].Type = csmSourceXPhysics;
-      context->Buffer->Outputs[context->OutputIndex].GetValue = GetOutputTranslationX;
-      context->Buffer->Outputs[context->OutputIndex].GetScale = GetOutputScaleTranslationX;
+      BindPhysicsOutput(&context->Buffer->Outputs[context->OutputIndex]);
     }
-    else if (DoesStringStartWith(jsonString + begin, "Y"))
+    else if (DoesSubStringStartWith(jsonString, begin, end, "Y"))
     {
       context->Buffer->Outputs[context->OutputIndex].Type = csmSourceYPhysics;
-      context->Buffer->Outputs[context->OutputIndex].GetValue = GetOutputTranslationY;
-      context->Buffer->Outputs[context->OutputIndex].GetScale = GetOutputScaleTranslationY;
+      BindPhysicsOutput(&context->Buffer->Outputs[context->OutputIndex]);
     }
-    else if (DoesStringStartWith(jsonString + begin, "Angle"))
+    else if (DoesSubStringStartWith(jsonString, begin, end, "Angle"))
     {
       context->Buffer->Outputs[context->OutputIndex].Type = csmSourceAnglePhysics;
-      context->Buffer->Outputs[context->OutputIndex].GetValue = GetOutputAngle;
-      context->Buffer->Outputs[context->OutputIndex].GetScale = GetOutputScaleAngle;
+      BindPhysicsOutput(&context->Buffer->Outputs[context->OutputIndex]);
     }
 
     context->State = ReadingOutput;
@@ -1240,23 +1233,23 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Position"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Position"))
       {
         context->State = ReadingVerticesPosition;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Mobility"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Mobility"))
       {
         context->State = ReadingVerticesMobility;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Delay"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Delay"))
       {
         context->State = ReadingVerticesDelay;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Acceleration"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Acceleration"))
       {
         context->State = ReadingVerticesAcceleration;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Radius"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Radius"))
       {
         context->State = ReadingVerticesRadius;
       }
@@ -1276,11 +1269,11 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "X"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "X"))
       {
         context->State = ReadingVerticesPositionX;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Y"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Y"))
       {
         context->State = ReadingVerticesPositionY;
       }
@@ -1294,7 +1287,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesPositionX:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].InitialPosition.X);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].InitialPosition.X);
 
     context->State = ReadingVerticesPosition;
 
@@ -1305,7 +1298,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesPositionY:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].InitialPosition.Y);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].InitialPosition.Y);
 
     context->State = ReadingVerticesPosition;
 
@@ -1316,7 +1309,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesMobility:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].Mobility);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].Mobility);
 
     context->State = ReadingVertices;
 
@@ -1327,7 +1320,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesDelay:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].Delay);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].Delay);
 
     context->State = ReadingVertices;
 
@@ -1338,7 +1331,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesAcceleration:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].Acceleration);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].Acceleration);
 
     context->State = ReadingVertices;
 
@@ -1349,7 +1342,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingVerticesRadius:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Particles[context->VertexIndex].Radius);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Particles[context->VertexIndex].Radius);
 
     context->State = ReadingVertices;
 
@@ -1366,11 +1359,11 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Position"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Position"))
       {
         context->State = ReadingNormalizationPosition;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Angle"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Angle"))
       {
         context->State = ReadingNormalizationAngle;
       }
@@ -1390,15 +1383,15 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Minimum"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Minimum"))
       {
         context->State = ReadingNormalizationPositionMinimum;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Default"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Default"))
       {
         context->State = ReadingNormalizationPositionDefault;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Maximum"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Maximum"))
       {
         context->State = ReadingNormalizationPositionMaximum;
       }
@@ -1412,7 +1405,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationPositionMinimum:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Minimum);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Minimum);
 
     context->State = ReadingNormalizationPosition;
 
@@ -1423,7 +1416,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationPositionDefault:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Default);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Default);
 
     context->State = ReadingNormalizationPosition;
 
@@ -1434,7 +1427,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationPositionMaximum:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Maximum);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationPosition.Maximum);
 
     context->State = ReadingNormalizationPosition;
 
@@ -1451,15 +1444,15 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
     }
     else
     {
-      if (DoesStringStartWith(jsonString + begin, "Minimum"))
+      if (DoesSubStringStartWith(jsonString, begin, end, "Minimum"))
       {
         context->State = ReadingNormalizationAngleMinimum;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Default"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Default"))
       {
         context->State = ReadingNormalizationAngleDefault;
       }
-      else if (DoesStringStartWith(jsonString + begin, "Maximum"))
+      else if (DoesSubStringStartWith(jsonString, begin, end, "Maximum"))
       {
         context->State = ReadingNormalizationAngleMaximum;
       }
@@ -1473,7 +1466,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationAngleMinimum:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Minimum);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Minimum);
 
     context->State = ReadingNormalizationAngle;
 
@@ -1484,7 +1477,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationAngleDefault:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Default);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Default);
 
     context->State = ReadingNormalizationAngle;
 
@@ -1495,7 +1488,7 @@ static int ParsePhysics3(const char* jsonString, csmJsonTokenType type, int begi
   // TODO Document
   case ReadingNormalizationAngleMaximum:
   {
-    ReadFloatFromString(jsonString + begin, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Maximum);
+    ReadFloatFromSubString(jsonString, begin, end, &context->Buffer->Settings[context->SettingIndex].NormalizationAngle.Maximum);
 
     context->State = ReadingNormalizationAngle;
 
@@ -1536,39 +1529,109 @@ static csmJsonTokenHandler PhysicsParsers[] =
 };
 
 
-// TODO Document
-void ReadPhysicsJsonMeta(const char* physicsJson, PhysicsJsonMeta* buffer)
+/// Feeds JSON tokens to a handler.
+///
+/// @param  physicsJson  Physics JSON string.
+/// @param  length       Length of JSON string (in chars).
+/// @param  tape         [Optional] Token tape to replay instead of lexing.
+/// @param  tokenCount   Number of tokens in tape.
+/// @param  onToken      Token handler.
+/// @param  userData     Data to pass to token handler.
+static void LexOrReplayJson(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount, csmJsonTokenHandler onToken, void* userData)
+{
+  if (tape)
+  {
+    csmReplayJsonTape(physicsJson, tape, tokenCount, onToken, userData);
+  }
+  else
+  {
+    csmLexJsonWithLength(physicsJson, (unsigned int)length, onToken, userData);
+  }
+}
+
+
+/// Reads version of serialized physics.
+///
+/// @param  physicsJson  Physics JSON string.
+/// @param  length       Length of JSON string (in chars).
+/// @param  tape         [Optional] Token tape to replay instead of lexing.
+/// @param  tokenCount   Number of tokens in tape.
+///
+/// @return  Version.
+static int ReadVersion(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount)
+{
+  VersionParserContext context;
+  int version;
+
+
+  InitializeVersionParserContext(&context, &version);
+  LexOrReplayJson(physicsJson, length, tape, tokenCount, ParseVersion, &context);
+
+
+  return version;
+}
+
+
+void ReadPhysicsJsonMeta(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount, PhysicsJsonMeta* buffer)
 {
-  VersionParserContext versionParserContext;
   MetaParserContext context;
   int version;
 
 
   // Get version info.
-  InitializeVersionParserContext(&versionParserContext, &version);
-  csmLexJson(physicsJson, ParseVersion, &versionParserContext);
+  version = ReadVersion(physicsJson, length, tape, tokenCount);
 
 
   // Parse matching version.
   InitializeMetaParserContext(&context, buffer);
-  csmLexJson(physicsJson, MetaParsers[version], &context);
+  LexOrReplayJson(physicsJson, length, tape, tokenCount, MetaParsers[version], &context);
 }
 
 
-// TODO Document
-void ReadPhysicsJson(const char* physicsJson, csmPhysicsRig* buffer)
+void ReadPhysicsJson(const char* physicsJson, const int length, const csmJsonToken* tape, const int tokenCount, csmPhysicsRig* buffer)
 {
-  VersionParserContext versionParserContext;
+  MetaParserContext metaParserContext;
   PhysicsParserContext context;
   int version;
 
 
   // Get version info.
-  InitializeVersionParserContext(&versionParserContext, &version);
-  csmLexJson(physicsJson, ParseVersion, &versionParserContext);
+  version = ReadVersion(physicsJson, length, tape, tokenCount);
 
 
-  // Parse matching version.
+  // Parse meta matching version.
   InitializePhysicsParserContext(&context, buffer);
-  csmLexJson(physicsJson, PhysicsParsers[version], &context);
+  InitializeMetaParserContext(&metaParserContext, &context.Meta);
+  LexOrReplayJson(physicsJson, length, tape, tokenCount, MetaParsers[version], &metaParserContext);
+
+
+  // Initialize data fields.
+  buffer->Gravity = context.Meta.EffectiveForces.Gravity;
+
+  buffer->Wind = context.Meta.EffectiveForces.Wind;
+
+  buffer->SubRigCount = context.Meta.SubRigCount;
+
+
+  // Initialize pointer fields.
+  buffer->Settings = (csmPhysicsSubRig*)(buffer + 1);
+  buffer->Inputs = (csmPhysicsInput*)(buffer->Settings + context.Meta.SubRigCount);
+  buffer->Outputs = (csmPhysicsOutput*)(buffer->Inputs + context.Meta.TotalInputCount);
+  buffer->Particles = (csmPhysicsParticle*)(buffer->Outputs + context.Meta.TotalOutputCount);
+
+
+  // Parse matching version.
+  LexOrReplayJson(physicsJson, length, tape, tokenCount, PhysicsParsers[version], &context);
+}
+
+
+void BindPhysicsInput(csmPhysicsInput* input)
+{
+  input->GetNormalizedParameterValue = NormalizedParameterValueGetters[input->Type];
+}
+
+void BindPhysicsOutput(csmPhysicsOutput* output)
+{
+  output->GetValue = ValueGetters[output->Type];
+  output->GetScale = ScaleGetters[output->Type];
 }
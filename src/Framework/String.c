@@ -13,29 +13,620 @@
 // REQUIRES //
 // -------- //
 
-#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Powers of ten exactly representable as floats.
+static const float FloatPowersOfTen[] =
+{
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/// Powers of ten exactly representable as doubles.
+static const double DoublePowersOfTen[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+  1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+  1e21, 1e22
+};
+
+
+/// Number of significant digits gathered for the fast paths.
+#define FastDigitCount 19
+
+/// Number of significant digits gathered for exact comparisons.
+///
+/// Any float rounding midpoint has less significant digits, so truncating behind them (and remembering whether non-zero
+/// digits were dropped) keeps comparisons exact.
+#define ExactDigitCount 125
+
+/// Number of 32-bit limbs of a big integer (which covers the largest products that occur while comparing).
+#define BigLimbCount 64
+
+
+/// Arbitrary precision unsigned integer.
+typedef struct BigInteger
+{
+  /// Limbs (least significant first).
+  unsigned int Limbs[BigLimbCount];
+
+  /// Number of limbs in use.
+  int LimbCount;
+}
+BigInteger;
+
+
+/// Decimal number split into its parts.
+typedef struct DecimalNumber
+{
+  /// Significant digits as integer.
+  unsigned long long Mantissa;
+
+  /// Number of significant digits in mantissa.
+  int DigitCount;
+
+  /// Decimal exponent to apply to mantissa.
+  int Exponent;
+
+  /// Non-zero if non-zero digits didn't fit into mantissa.
+  int IsTruncated;
+
+  /// Non-zero if number is negative.
+  int IsNegative;
+}
+DecimalNumber;
+
+
+/// Checks whether a char is a decimal digit.
+///
+/// @param  c  Char to check.
+///
+/// @return  Non-zero if char is a digit; '0' otherwise.
+static inline int IsDigit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+
+/// Multiplies a big integer by a small factor and adds a small value.
+///
+/// @param  integer  Integer to modify.
+/// @param  factor   Factor to multiply with.
+/// @param  addend   Value to add.
+static void MultiplyAddBigInteger(BigInteger* integer, const unsigned int factor, const unsigned int addend)
+{
+  unsigned long long product;
+  int l;
+
+
+  for (product = addend, l = 0; l < integer->LimbCount; ++l)
+  {
+    product += (unsigned long long)integer->Limbs[l] * factor;
+
+    integer->Limbs[l] = (unsigned int)product;
+
+    product >>= 32;
+  }
+
+
+  if (product && integer->LimbCount < BigLimbCount)
+  {
+    integer->Limbs[integer->LimbCount] = (unsigned int)product;
+
+    integer->LimbCount += 1;
+  }
+}
+
+
+/// Multiplies a big integer by a power of five.
+///
+/// @param  integer   Integer to modify.
+/// @param  exponent  Exponent of five.
+static void MultiplyBigIntegerByPowerOfFive(BigInteger* integer, int exponent)
+{
+  // Multiply by 5^13 (the largest power of five fitting into 32 bits) as long as possible...
+  for (; exponent >= 13; exponent -= 13)
+  {
+    MultiplyAddBigInteger(integer, 1220703125u, 0);
+  }
+
+
+  // ... and by the remainder.
+  for (; exponent > 0; --exponent)
+  {
+    MultiplyAddBigInteger(integer, 5u, 0);
+  }
+}
+
+
+/// Shifts a big integer to the left.
+///
+/// @param  integer  Integer to modify.
+/// @param  shift    Number of bits to shift by.
+static void ShiftBigIntegerLeft(BigInteger* integer, const int shift)
+{
+  int limbShift, bitShift, l;
+
+
+  limbShift = shift / 32;
+  bitShift = shift % 32;
+
+
+  // Grow integer (dropping limbs that don't fit).
+  if ((integer->LimbCount + limbShift + 1) > BigLimbCount)
+  {
+    Log("[Live2D Cubism Components] Number too big for exact float comparison.");
+
+
+    limbShift = BigLimbCount - integer->LimbCount - 1;
+  }
+
+
+  integer->Limbs[integer->LimbCount + limbShift] = 0;
+
+
+  for (l = integer->LimbCount - 1; l >= 0; --l)
+  {
+    integer->Limbs[l + limbShift + 1] |= (bitShift)
+      ? (integer->Limbs[l] >> (32 - bitShift))
+      : 0;
+    integer->Limbs[l + limbShift] = integer->Limbs[l] << bitShift;
+  }
+
+
+  for (l = 0; l < limbShift; ++l)
+  {
+    integer->Limbs[l] = 0;
+  }
+
+
+  integer->LimbCount += limbShift + 1;
+
+
+  // Trim leading zero limbs.
+  for (; integer->LimbCount > 0 && !integer->Limbs[integer->LimbCount - 1]; --integer->LimbCount)
+  {
+    ;
+  }
+}
+
+
+/// Compares two big integers.
+///
+/// @param  a  First integer.
+/// @param  b  Second integer.
+///
+/// @return  Negative value if 'a' is smaller, positive value if 'a' is bigger; '0' otherwise.
+static int CompareBigIntegers(const BigInteger* a, const BigInteger* b)
+{
+  int l;
+
+
+  if (a->LimbCount != b->LimbCount)
+  {
+    return (a->LimbCount < b->LimbCount)
+      ? -1
+      : 1;
+  }
+
+
+  for (l = a->LimbCount - 1; l >= 0; --l)
+  {
+    if (a->Limbs[l] != b->Limbs[l])
+    {
+      return (a->Limbs[l] < b->Limbs[l])
+        ? -1
+        : 1;
+    }
+  }
+
+
+  return 0;
+}
+
+
+/// Scans a decimal number.
+///
+/// @param  string             String to scan.
+/// @param  begin              Inclusive offset into string to start scanning at.
+/// @param  end                Exclusive offset into string to stop scanning at.
+/// @param  maximumDigitCount  Maximum number of significant digits to gather.
+/// @param  number             Number to write parts to.
+/// @param  digits             [Optional] Integer to gather significant digits into (instead of the number mantissa).
+///
+/// @return  Offset behind number on success; 'begin' if no number found.
+static int ScanDecimal(const char* string,
+                       const int begin,
+                       const int end,
+                       const int maximumDigitCount,
+                       DecimalNumber* number,
+                       BigInteger* digits)
+{
+  int position, hasDigits, isFraction, exponent, exponentBegin, isExponentNegative;
+  unsigned int digit;
+
+
+  number->Mantissa = 0;
+  number->DigitCount = 0;
+  number->Exponent = 0;
+  number->IsTruncated = 0;
+  number->IsNegative = 0;
+
+
+  position = begin;
+
+
+  // Scan sign.
+  if (position < end && (string[position] == '-' || string[position] == '+'))
+  {
+    number->IsNegative = (string[position] == '-');
+
+
+    ++position;
+  }
+
+
+  // Scan integer and fraction digits.
+  for (hasDigits = 0, isFraction = 0; position < end; ++position)
+  {
+    if (string[position] == '.' && !isFraction)
+    {
+      isFraction = 1;
+
+
+      continue;
+    }
+
+
+    if (!IsDigit(string[position]))
+    {
+      break;
+    }
+
+
+    hasDigits = 1;
+    digit = (unsigned int)(string[position] - '0');
+
+
+    // Skip leading zeros...
+    if (!number->DigitCount && !digit)
+    {
+      number->Exponent -= isFraction;
+    }
+
+
+    // ... gather significant digits...
+    else if (number->DigitCount < maximumDigitCount)
+    {
+      if (digits)
+      {
+        MultiplyAddBigInteger(digits, 10, digit);
+      }
+      else
+      {
+        number->Mantissa = (number->Mantissa * 10) + digit;
+      }
+
+
+      number->DigitCount += 1;
+      number->Exponent -= isFraction;
+    }
+
+
+    // ... and only keep track of scale and remainder of all others.
+    else
+    {
+      number->Exponent += !isFraction;
+      number->IsTruncated |= (digit != 0);
+    }
+  }
+
+
+  if (!hasDigits)
+  {
+    return begin;
+  }
+
+
+  // Scan exponent (clamping it to a range far beyond float range).
+  if ((position + 1) < end && (string[position] == 'e' || string[position] == 'E'))
+  {
+    exponentBegin = position;
+
+
+    ++position;
+
+
+    isExponentNegative = (string[position] == '-');
+
+
+    if (string[position] == '-' || string[position] == '+')
+    {
+      ++position;
+    }
+
+
+    if (position >= end || !IsDigit(string[position]))
+    {
+      return exponentBegin;
+    }
+
+
+    for (exponent = 0; position < end && IsDigit(string[position]); ++position)
+    {
+      if (exponent < 100000)
+      {
+        exponent = (exponent * 10) + (string[position] - '0');
+      }
+    }
+
+
+    number->Exponent += (isExponentNegative)
+      ? -exponent
+      : exponent;
+  }
+
+
+  return position;
+}
+
+
+/// Compares a decimal number against a binary number exactly.
+///
+/// @param  string  String containing decimal number.
+/// @param  begin   Inclusive offset into string where number begins.
+/// @param  end     Exclusive offset into string where number ends.
+/// @param  binary  Non-negative binary number to compare against.
+///
+/// @return  Negative value if magnitude of decimal is smaller, positive value if it is bigger; '0' otherwise.
+static int CompareDecimalWithBinary(const char* string, const int begin, const int end, const double binary)
+{
+  BigInteger decimalSide, binarySide;
+  DecimalNumber decimal;
+  int binaryExponent, comparison;
+
+
+  // Gather decimal as 'digits * 5^exponent * 2^exponent'...
+  decimalSide.LimbCount = 0;
+
+
+  ScanDecimal(string, begin, end, ExactDigitCount, &decimal, &decimalSide);
+
+
+  // ... and binary as 'mantissa * 2^binaryExponent'.
+  binarySide.Limbs[0] = (unsigned int)ldexp(frexp(binary, &binaryExponent), 32);
+  binarySide.LimbCount = (binarySide.Limbs[0])
+    ? 1
+    : 0;
+  binaryExponent -= 32;
+
+
+  // Move powers of five to one side...
+  if (decimal.Exponent >= 0)
+  {
+    MultiplyBigIntegerByPowerOfFive(&decimalSide, decimal.Exponent);
+  }
+  else
+  {
+    MultiplyBigIntegerByPowerOfFive(&binarySide, -decimal.Exponent);
+  }
+
+
+  // ... and powers of two to the other.
+  if (decimal.Exponent > binaryExponent)
+  {
+    ShiftBigIntegerLeft(&decimalSide, decimal.Exponent - binaryExponent);
+  }
+  else
+  {
+    ShiftBigIntegerLeft(&binarySide, binaryExponent - decimal.Exponent);
+  }
+
+
+  comparison = CompareBigIntegers(&decimalSide, &binarySide);
+
+
+  // Account for truncated digits.
+  return (!comparison && decimal.IsTruncated)
+    ? 1
+    : comparison;
+}
+
+
+/// Rounds a decimal number close to a float midpoint.
+///
+/// @param  string  String containing decimal number.
+/// @param  begin   Inclusive offset into string where number begins.
+/// @param  end     Exclusive offset into string where number ends.
+/// @param  lower   Float below number.
+/// @param  upper   Float above number.
+///
+/// @return  Correctly rounded float.
+static float RoundDecimalAtMidpoint(const char* string, const int begin, const int end, const float lower, const float upper)
+{
+  int comparison;
+  union
+  {
+    float Value;
+
+    unsigned int Bits;
+  }
+  even;
+
+
+  comparison = CompareDecimalWithBinary(string, begin, end, ((double)lower + (double)upper) * 0.5);
+
+
+  if (comparison)
+  {
+    return (comparison < 0)
+      ? lower
+      : upper;
+  }
+
+
+  // Round ties to even.
+  even.Value = lower;
+
+
+  return (even.Bits & 1)
+    ? upper
+    : lower;
+}
 
 
 // -------------- //
 // IMPLEMENTATION //
 // -------------- //
 
-void ReadFloatFromString(const char* string, float* buffer)
+int ScanFloat(const char* string, const int begin, const int end, float* buffer)
+{
+  DecimalNumber number;
+  double approximation, tolerance, midpoint;
+  float result, neighbor;
+  int position, exponent;
+
+
+  position = ScanDecimal(string, begin, end, FastDigitCount, &number, 0);
+
+
+  if (position == begin)
+  {
+    *buffer = 0.0f;
+
+
+    return begin;
+  }
+
+
+  // Handle zeros and values out of float range.
+  if (!number.Mantissa || (number.DigitCount + number.Exponent) < -46)
+  {
+    result = 0.0f;
+  }
+  else if ((number.DigitCount + number.Exponent) > 39)
+  {
+    result = HUGE_VALF;
+  }
+
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  // Compute exactly representable values with a single rounding step...
+  else if (!number.IsTruncated && number.Mantissa <= (1u << 24) && number.Exponent >= -10 && number.Exponent <= 10)
+  {
+    result = (number.Exponent < 0)
+      ? (float)number.Mantissa / FloatPowersOfTen[-number.Exponent]
+      : (float)number.Mantissa * FloatPowersOfTen[number.Exponent];
+  }
+#endif
+
+
+  // ... and approximate all other values, falling back to exact comparison only near float midpoints.
+  else
+  {
+    approximation = (double)number.Mantissa;
+
+
+    for (exponent = number.Exponent; exponent < -22; exponent += 22)
+    {
+      approximation /= DoublePowersOfTen[22];
+    }
+    for (; exponent > 22; exponent -= 22)
+    {
+      approximation *= DoublePowersOfTen[22];
+    }
+
+
+    approximation = (exponent < 0)
+      ? approximation / DoublePowersOfTen[-exponent]
+      : approximation * DoublePowersOfTen[exponent];
+
+
+    // (The approximation is off by a couple of double ulps at most.)
+    tolerance = approximation * (1.0 / 281474976710656.0);
+    result = (float)approximation;
+
+
+    // Check midpoint above...
+    neighbor = nextafterf(result, HUGE_VALF);
+    midpoint = ((double)result + (double)neighbor) * 0.5;
+
+
+    if (result < FLT_MAX && fabs(approximation - midpoint) <= tolerance)
+    {
+      result = RoundDecimalAtMidpoint(string, begin, position, result, neighbor);
+    }
+
+
+    // ... and below result.
+    else if (result > 0.0f)
+    {
+      neighbor = nextafterf(result, 0.0f);
+      midpoint = ((double)result + (double)neighbor) * 0.5;
+
+
+      if (fabs(approximation - midpoint) <= tolerance)
+      {
+        result = RoundDecimalAtMidpoint(string, begin, position, neighbor, result);
+      }
+    }
+  }
+
+
+  *buffer = (number.IsNegative)
+    ? -result
+    : result;
+
+
+  return position;
+}
+
+
+void ReadFloatFromSubString(const char* string, const int begin, const int end, float* buffer)
 {
-  *buffer = (float)atof(string);
+  ScanFloat(string, begin, end, buffer);
 }
 
-void ReadIntFromString(const char* string, int* buffer)
+void ReadIntFromSubString(const char* string, const int begin, const int end, int* buffer)
 {
-  *buffer = atoi(string);
+  int position, isNegative, value;
+
+
+  position = begin;
+  isNegative = (position < end && string[position] == '-');
+
+
+  if (position < end && (string[position] == '-' || string[position] == '+'))
+  {
+    ++position;
+  }
+
+
+  for (value = 0; position < end && IsDigit(string[position]); ++position)
+  {
+    value = (value * 10) + (string[position] - '0');
+  }
+
+
+  *buffer = (isNegative)
+    ? -value
+    : value;
 }
 
 
-int DoesStringStartWith(const char* string, const char* expected)
+int DoesSubStringStartWith(const char* string, const int begin, const int end, const char* expected)
 {
-  for (; *string != '\0' && *expected != '\0'; ++string, ++expected)
+  int c;
+
+
+  for (c = begin; *expected != '\0'; ++c, ++expected)
   {
-    if (*string != *expected)
+    if (c >= end || string[c] != *expected)
     {
       return 0;
     }
@@ -0,0 +1,270 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Scans a float (see 'src/Framework/Local.h').
+int ScanFloat(const char* string, const int begin, const int end, float* buffer);
+
+
+/// Number of random digit strings to scan.
+static const int DigitStringCount = 200000;
+
+/// Number of random floats to scan midpoints around.
+static const int MidpointCount = 50000;
+
+/// Maximum number of mismatches to report.
+static const int MaxReportCount = 16;
+
+
+/// Logs a message to standard error (in place of framework logging, which requires the Cubism Core library).
+///
+/// @param  message  Message to log.
+void Log(const char* message)
+{
+  fprintf(stderr, "%s\n", message);
+}
+
+
+/// State of the pseudo-random generator.
+static unsigned int RandomState = 1;
+
+
+/// Number of strings scanned differently.
+static int MismatchCount = 0;
+
+
+/// Draws a pseudo-random number (so that generated input is the same on every run).
+///
+/// @param  count  Number of values to draw from (at most '65536').
+///
+/// @return  Number in '[0, count)'.
+static int Random(const int count)
+{
+  RandomState = (RandomState * 1103515245u) + 12345u;
+
+
+  return (int)((RandomState >> 16) % (unsigned int)count);
+}
+
+
+/// Draws a random number of digits (mostly short, but sometimes exceeding exactly scanned mantissas).
+///
+/// @return  Number of digits.
+static int RandomDigitCount(void)
+{
+  return (Random(2))
+    ? Random(8)
+    : Random(40);
+}
+
+
+/// Scans a string with both 'ScanFloat()' and 'strtof()' and compares results bit for bit.
+///
+/// @param  string  Null-terminated string to scan.
+///
+/// @return  Non-zero if results match; '0' otherwise.
+static int DoScansMatch(const char* string)
+{
+  float expected, actual;
+  char* expectedEnd;
+  int length, actualEnd;
+
+
+  length = (int)strlen(string);
+  expected = strtof(string, &expectedEnd);
+  actualEnd = ScanFloat(string, 0, length, &actual);
+
+
+  if (actualEnd == (int)(expectedEnd - string) && !memcmp(&actual, &expected, sizeof(float)))
+  {
+    return 1;
+  }
+
+
+  if (MismatchCount < MaxReportCount)
+  {
+    printf("Scanned %s as %.9g (%d chars) instead of %.9g (%d chars).\n",
+           string,
+           actual,
+           actualEnd,
+           expected,
+           (int)(expectedEnd - string));
+  }
+
+
+  ++MismatchCount;
+
+
+  return 0;
+}
+
+
+/// Scans random digit strings (covering long mantissas, leading zeros, and exponents beyond float range).
+static void TestDigitStrings(void)
+{
+  static const char* exponentPrefixes[] = { "e", "E", "e+", "E+" };
+  char string[128];
+  int s, d, length, integerDigitCount, fractionDigitCount;
+
+
+  for (s = 0; s < DigitStringCount; ++s)
+  {
+    length = 0;
+
+
+    if (Random(2))
+    {
+      string[length++] = '-';
+    }
+
+
+    integerDigitCount = RandomDigitCount() + 1;
+    fractionDigitCount = (Random(3))
+      ? RandomDigitCount()
+      : 0;
+
+
+    for (d = 0; d < integerDigitCount; ++d)
+    {
+      string[length++] = (char)('0' + Random(10));
+    }
+
+
+    if (fractionDigitCount)
+    {
+      string[length++] = '.';
+
+
+      for (d = 0; d < fractionDigitCount; ++d)
+      {
+        string[length++] = (char)('0' + Random(10));
+      }
+    }
+
+
+    // Place magnitudes anywhere from below smallest subnormal to above largest float.
+    if (Random(3))
+    {
+      length += sprintf(string + length, "%s%d", exponentPrefixes[Random(4)], Random(100) - 60);
+    }
+
+
+    string[length] = '\0';
+
+
+    DoScansMatch(string);
+  }
+}
+
+
+/// Scans a double printed with 121 significant digits (which is exact for midpoints between floats).
+///
+/// @param  value  Value to scan.
+/// @param  tail   Digits to append to significant digits.
+static void ScanDouble(const double value, const char* tail)
+{
+  char string[256], * exponent;
+
+
+  sprintf(string, "%.120e", value);
+
+
+  exponent = strchr(string, 'e');
+
+
+  memmove(exponent + strlen(tail), exponent, strlen(exponent) + 1);
+  memcpy(exponent, tail, strlen(tail));
+
+
+  DoScansMatch(string);
+}
+
+
+/// Scans exact midpoints between random floats and their upper neighbors, as well as the closest numbers around them.
+static void TestMidpoints(void)
+{
+  unsigned int bits;
+  double midpoint;
+  float lower, upper;
+  int m;
+
+
+  for (m = 0; m < MidpointCount; ++m)
+  {
+    // Draw any finite positive float (including subnormals and largest float).
+    bits = ((unsigned int)Random(0x7F80) << 16) | (unsigned int)Random(0x10000);
+
+
+    memcpy(&lower, &bits, sizeof(float));
+
+
+    upper = nextafterf(lower, HUGE_VALF);
+    midpoint = (lower < FLT_MAX)
+      ? ((double)lower + (double)upper) * 0.5
+      : ((double)lower + ldexp(1.0, 128)) * 0.5;
+
+
+    ScanDouble(midpoint, "");
+    ScanDouble(nextafter(midpoint, 0.0), "");
+    ScanDouble(nextafter(midpoint, HUGE_VAL), "");
+
+
+    // Move midpoint up by a digit beyond the ones compared exactly.
+    ScanDouble(midpoint, "000000001");
+  }
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+/// Compares float scanning with 'strtof()' in the "C" locale.
+///
+/// @return  '0' if all scans match; '1' otherwise.
+int main(void)
+{
+  setlocale(LC_ALL, "C");
+
+
+  TestDigitStrings();
+  TestMidpoints();
+
+
+  if (MismatchCount)
+  {
+    printf("%d strings scanned differently.\n", MismatchCount);
+
+
+    return 1;
+  }
+
+
+  printf("All strings scanned identically.\n");
+
+
+  return 0;
+}
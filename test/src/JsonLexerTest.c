@@ -0,0 +1,890 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Lexes JSON into a tape with scalar fallbacks only (see 'CMakeLists.txt').
+int ScalarLexJsonIntoTapeWithLength(const char* jsonString, const unsigned int length, csmJsonToken* tape, const int capacity);
+
+/// Lexes JSON with the original switch lexer (see 'ReferenceJsonLexer.c').
+void ReferenceLexJson(const char* jsonString, csmJsonTokenHandler onToken, void* userData);
+
+
+/// Lexer writing into a tape.
+typedef int (*TapeLexer)(const char* jsonString, const unsigned int length, csmJsonToken* tape, const int capacity);
+
+
+/// Lexers to test.
+static const TapeLexer Lexers[] = { csmLexJsonIntoTapeWithLength, ScalarLexJsonIntoTapeWithLength };
+
+/// Names of lexers to test.
+static const char* LexerNames[] = { "SIMD", "scalar" };
+
+/// Number of lexers to test.
+#define LexerCount 2
+
+
+/// Offsets to place tokens at (covering 2 blocks of the widest SIMD path).
+static const int OffsetCount = 64;
+
+/// Number of random documents to generate.
+static const int DocumentCount = 64;
+
+/// Maximum nesting depth of random documents.
+static const int MaxDocumentDepth = 6;
+
+/// Number of whitespace chars to pad input of original lexer with (so that it doesn't read past the end of literals).
+static const int ReferencePadding = 6;
+
+
+/// Snippets to place at every offset.
+static const char* Snippets[] =
+{
+  "{", "}", "[", "]",
+  "\"\"", "\"a\"", "\"a\":", "\"a\" :", "\"{[]}tfn-0\"",
+  "true", "false", "null", "tru", "fals", "nul",
+  "0", "7", "-", "-1", "3.25", "-0.5e+12", "1E-3",
+  ":", ",", ".", "e", "+", "x", "\t", "\r\n"
+};
+
+
+/// Chars to fill non-token space with (neither of which starts a token).
+static const char Fillers[] = " \t\n\r,:xe.+";
+
+
+/// Intended difference to the original lexer (as input with token streams of both lexers).
+typedef struct IntendedDifference
+{
+  /// Input (padded for original lexer).
+  const char* Json;
+
+  /// Description.
+  const char* Description;
+
+  /// Number of tokens of current lexers.
+  int TokenCount;
+
+  /// Tokens of current lexers.
+  csmJsonToken Tokens[4];
+
+  /// Number of tokens of original lexer ('-1' if it reads past the end of input).
+  int ReferenceTokenCount;
+
+  /// Tokens of original lexer.
+  csmJsonToken ReferenceTokens[4];
+}
+IntendedDifference;
+
+
+/// Intended differences to the original lexer.
+static const IntendedDifference IntendedDifferences[] =
+{
+  {
+    "[true]  ",
+    "Literals end right after their last char (and don't skip the 2 chars following them).",
+    3, { { csmJsonArrayBegin, 0, 1 }, { csmJsonTrue, 1, 5 }, { csmJsonArrayEnd, 5, 6 } },
+    2, { { csmJsonArrayBegin, 0, 1 }, { csmJsonTrue, 1, 6 } }
+  },
+  {
+    "[1]  ",
+    "Numbers don't skip the char following them.",
+    3, { { csmJsonArrayBegin, 0, 1 }, { csmJsonNumber, 1, 2 }, { csmJsonArrayEnd, 2, 3 } },
+    2, { { csmJsonArrayBegin, 0, 1 }, { csmJsonNumber, 1, 2 } }
+  },
+  {
+    "[1e+5]  ",
+    "Exponents are part of numbers.",
+    3, { { csmJsonArrayBegin, 0, 1 }, { csmJsonNumber, 1, 5 }, { csmJsonArrayEnd, 5, 6 } },
+    3, { { csmJsonArrayBegin, 0, 1 }, { csmJsonNumber, 1, 2 }, { csmJsonNumber, 4, 5 } }
+  },
+  {
+    "{\"a\" :1}  ",
+    "Names may be followed by whitespace before their colon.",
+    4, { { csmJsonObjectBegin, 0, 1 }, { csmJsonName, 2, 3 }, { csmJsonNumber, 6, 7 }, { csmJsonObjectEnd, 7, 8 } },
+    3, { { csmJsonObjectBegin, 0, 1 }, { csmJsonString, 2, 3 }, { csmJsonNumber, 6, 7 } }
+  },
+  {
+    "[tru",
+    "Lexing stops at truncated literals.",
+    1, { { csmJsonArrayBegin, 0, 1 } },
+    -1, { { csmJsonArrayBegin, 0, 0 } }
+  },
+  {
+    "[\"a",
+    "Lexing stops at unterminated strings.",
+    1, { { csmJsonArrayBegin, 0, 1 } },
+    -1, { { csmJsonArrayBegin, 0, 0 } }
+  }
+};
+
+
+/// Logs a message to standard error (in place of framework logging, which requires the Cubism Core library).
+///
+/// @param  message  Message to log.
+void Log(const char* message)
+{
+  fprintf(stderr, "%s\n", message);
+}
+
+
+/// State of the pseudo-random generator.
+static unsigned int RandomState = 1;
+
+
+/// Number of inputs compared against the original lexer.
+static int ReferenceComparisonCount = 0;
+
+/// Number of inputs not compared against the original lexer (because it loses track of them).
+static int ReferenceSkipCount = 0;
+
+
+/// Draws a pseudo-random number (so that generated input is the same on every run).
+///
+/// @param  count  Number of values to draw from.
+///
+/// @return  Number in '[0, count)'.
+static int Random(const int count)
+{
+  RandomState = (RandomState * 1103515245u) + 12345u;
+
+
+  return (int)((RandomState >> 16) % (unsigned int)count);
+}
+
+
+/// Buffer for generated JSON.
+typedef struct JsonBuffer
+{
+  /// Chars.
+  char* Chars;
+
+  /// Number of chars.
+  int Length;
+
+  /// Maximum number of chars.
+  int Capacity;
+}
+JsonBuffer;
+
+
+/// Appends a string to a buffer (dropping chars that don't fit).
+///
+/// @param  buffer  Buffer to append to.
+/// @param  string  String to append.
+static void Append(JsonBuffer* buffer, const char* string)
+{
+  for (; *string && buffer->Length < buffer->Capacity; ++string)
+  {
+    buffer->Chars[buffer->Length++] = *string;
+  }
+}
+
+/// Appends random whitespace to a buffer.
+///
+/// @param  buffer  Buffer to append to.
+static void AppendWhitespace(JsonBuffer* buffer)
+{
+  static const char* whitespace[] = { "", "", " ", "\n", "  ", "\r\n\t", "                                 " };
+
+
+  Append(buffer, whitespace[Random((int)(sizeof(whitespace) / sizeof(whitespace[0])))]);
+}
+
+/// Appends a random value to a buffer.
+///
+/// @param  buffer  Buffer to append to.
+/// @param  depth   Nesting depth of value.
+static void AppendValue(JsonBuffer* buffer, const int depth)
+{
+  static const char* scalars[] =
+  {
+    "true", "false", "null", "0", "-1", "42", "3.1415", "-2.5e-7", "1E+9",
+    "\"\"", "\"Id\"", "\"ParamAngleX\"", "\"{\\\"[1, 2]\\\"}\"", "\"true false null -0\""
+  };
+  static const char* names[] = { "\"Meta\"", "\"Curves\"", "\"Segments\"", "\"\"", "\"a:b\"" };
+  int i, count;
+
+
+  AppendWhitespace(buffer);
+
+
+  // Place scalars at leaves (and sometimes inside containers).
+  if (depth >= MaxDocumentDepth || Random(3) == 0)
+  {
+    Append(buffer, scalars[Random((int)(sizeof(scalars) / sizeof(scalars[0])))]);
+    AppendWhitespace(buffer);
+
+
+    return;
+  }
+
+
+  count = Random(6);
+
+
+  if (Random(2))
+  {
+    Append(buffer, "[");
+
+
+    for (i = 0; i < count; ++i)
+    {
+      if (i > 0)
+      {
+        Append(buffer, ",");
+      }
+
+
+      AppendValue(buffer, depth + 1);
+    }
+
+
+    AppendWhitespace(buffer);
+    Append(buffer, "]");
+  }
+  else
+  {
+    Append(buffer, "{");
+
+
+    for (i = 0; i < count; ++i)
+    {
+      if (i > 0)
+      {
+        Append(buffer, ",");
+      }
+
+
+      AppendWhitespace(buffer);
+      Append(buffer, names[Random((int)(sizeof(names) / sizeof(names[0])))]);
+      AppendWhitespace(buffer);
+      Append(buffer, ":");
+      AppendValue(buffer, depth + 1);
+    }
+
+
+    AppendWhitespace(buffer);
+    Append(buffer, "}");
+  }
+
+
+  AppendWhitespace(buffer);
+}
+
+
+/// Context for recording tokens of original lexer.
+typedef struct ReferenceRecorderContext
+{
+  /// Tape to write to.
+  csmJsonToken* Tape;
+
+  /// Maximum number of tokens to write.
+  int Capacity;
+
+  /// Number of tokens recorded.
+  int TokenCount;
+}
+ReferenceRecorderContext;
+
+
+/// Records a token of the original lexer.
+///
+/// @param  jsonString  [Unused] JSON string.
+/// @param  type        Token type.
+/// @param  begin       Begin of token (in chars).
+/// @param  end         End of token (in chars).
+/// @param  context     Recorder context.
+///
+/// @return  Non-zero as long as tape isn't full; '0' otherwise.
+static int RecordReferenceToken(const char* jsonString, const csmJsonTokenType type, const int begin, const int end, void* context)
+{
+  ReferenceRecorderContext* recorder;
+
+
+  (void)jsonString;
+
+
+  recorder = (ReferenceRecorderContext*)context;
+
+
+  recorder->Tape[recorder->TokenCount].Type = type;
+  recorder->Tape[recorder->TokenCount].Begin = begin;
+  recorder->Tape[recorder->TokenCount].End = end;
+
+
+  return ++recorder->TokenCount < recorder->Capacity;
+}
+
+
+/// Lexes JSON with the original lexer.
+///
+/// @param  json      JSON to lex (padded with whitespace and null-terminated).
+/// @param  tape      Tape to write to.
+/// @param  capacity  Maximum number of tokens to write.
+///
+/// @return  Number of tokens written.
+static int ReferenceLexJsonIntoTape(const char* json, csmJsonToken* tape, const int capacity)
+{
+  ReferenceRecorderContext recorder;
+
+
+  recorder.Tape = tape;
+  recorder.Capacity = capacity;
+  recorder.TokenCount = 0;
+
+
+  ReferenceLexJson(json, RecordReferenceToken, &recorder);
+
+
+  return recorder.TokenCount;
+}
+
+
+/// Checks whether a token is a bracket.
+///
+/// @param  token  Token to check.
+///
+/// @return  Non-zero if token is a bracket; '0' otherwise.
+static int IsBracket(const csmJsonToken* token)
+{
+  return token->Type == csmJsonObjectBegin
+    || token->Type == csmJsonObjectEnd
+    || token->Type == csmJsonArrayBegin
+    || token->Type == csmJsonArrayEnd;
+}
+
+
+/// Converts a token stream of the current lexers into the one the original lexer produces for the same input
+/// by applying the intended differences (see 'IntendedDifferences').
+///
+/// @param  json             Lexed JSON (padded with whitespace).
+/// @param  tokens           Tokens of current lexers.
+/// @param  tokenCount       Number of tokens of current lexers.
+/// @param  referenceTokens  Tokens of original lexer.
+///
+/// @return  Number of tokens of original lexer; '-1' if the original lexer loses track of tokens in input.
+static int ConvertToReferenceTokens(const char* json, const csmJsonToken* tokens, const int tokenCount, csmJsonToken* referenceTokens)
+{
+  int t, skipEnd, tokenStart, position, numberEnd, referenceTokenCount;
+
+
+  referenceTokenCount = 0;
+  skipEnd = 0;
+
+
+  for (t = 0; t < tokenCount; ++t)
+  {
+    tokenStart = (tokens[t].Type == csmJsonName || tokens[t].Type == csmJsonString)
+      ? tokens[t].Begin - 1
+      : tokens[t].Begin;
+
+
+    // The original lexer skipped chars following literals and numbers, dropping brackets there (and losing track of other tokens).
+    if (tokenStart < skipEnd)
+    {
+      if (IsBracket(tokens + t))
+      {
+        continue;
+      }
+
+
+      return -1;
+    }
+
+
+    switch (tokens[t].Type)
+    {
+      case csmJsonTrue:
+      case csmJsonFalse:
+      case csmJsonNull:
+      {
+        // Literals ended one char too far and skipped the 2 chars following them.
+        referenceTokens[referenceTokenCount] = tokens[t];
+        referenceTokens[referenceTokenCount].End += 1;
+
+
+        ++referenceTokenCount;
+
+
+        skipEnd = tokens[t].End + 2;
+
+
+        break;
+      }
+      case csmJsonNumber:
+      {
+        // Numbers didn't include exponents, so they were split at 'e' (which got skipped as following char),
+        // and signs of exponents weren't lexed at all.
+        for (position = tokens[t].Begin; position < tokens[t].End;)
+        {
+          if ((json[position] >= '0' && json[position] <= '9') || json[position] == '-')
+          {
+            for (numberEnd = position; numberEnd < tokens[t].End && ((json[numberEnd] >= '0' && json[numberEnd] <= '9') || json[numberEnd] == '-' || json[numberEnd] == '.'); ++numberEnd)
+            {
+              ;
+            }
+
+
+            referenceTokens[referenceTokenCount].Type = csmJsonNumber;
+            referenceTokens[referenceTokenCount].Begin = position;
+            referenceTokens[referenceTokenCount].End = numberEnd;
+
+
+            ++referenceTokenCount;
+
+
+            // Numbers skipped the char following them.
+            skipEnd = numberEnd + 1;
+            position = numberEnd + 1;
+          }
+          else
+          {
+            ++position;
+          }
+        }
+
+
+        break;
+      }
+      case csmJsonName:
+      case csmJsonString:
+      {
+        // Names had to be followed by a colon immediately.
+        referenceTokens[referenceTokenCount] = tokens[t];
+        referenceTokens[referenceTokenCount].Type = (json[tokens[t].End + 1] == ':')
+          ? csmJsonName
+          : csmJsonString;
+
+
+        ++referenceTokenCount;
+
+
+        break;
+      }
+      default:
+      {
+        referenceTokens[referenceTokenCount] = tokens[t];
+
+
+        ++referenceTokenCount;
+
+
+        break;
+      }
+    }
+  }
+
+
+  return referenceTokenCount;
+}
+
+
+/// Lexes JSON with both lexers and compares their token streams byte for byte.
+///
+/// JSON is copied into a block of its exact size, so that reads past its end are caught by memory checkers.
+///
+/// @param  name    Name of input (for reporting).
+/// @param  json    JSON to lex.
+/// @param  length  Length of JSON (in chars).
+///
+/// @return  Non-zero if token streams match; '0' otherwise.
+static int DoTokenStreamsMatch(const char* name, const char* json, const int length)
+{
+  csmJsonToken* simdTape, * scalarTape;
+  int simdCount, scalarCount, doMatch;
+  char* copy;
+
+
+  copy = malloc((length > 0)
+    ? (size_t)length
+    : 1);
+  simdTape = malloc(sizeof(csmJsonToken) * ((size_t)length + 1));
+  scalarTape = malloc(sizeof(csmJsonToken) * ((size_t)length + 1));
+
+
+  memcpy(copy, json, (size_t)length);
+
+
+  // Every token takes at least a char, so tapes can't overflow.
+  simdCount = csmLexJsonIntoTapeWithLength(copy, (unsigned int)length, simdTape, length + 1);
+  scalarCount = ScalarLexJsonIntoTapeWithLength(copy, (unsigned int)length, scalarTape, length + 1);
+
+
+  doMatch = simdCount == scalarCount
+    && !memcmp(simdTape, scalarTape, sizeof(csmJsonToken) * (size_t)simdCount);
+
+
+  if (!doMatch)
+  {
+    printf("Token streams of %s (%d chars) differ: %d tokens with SIMD, %d tokens without.\n", name, length, simdCount, scalarCount);
+  }
+
+
+  free(scalarTape);
+  free(simdTape);
+  free(copy);
+
+
+  return doMatch;
+}
+
+/// Lexes JSON with the current lexers and the original lexer and compares their token streams (taking intended differences into account).
+///
+/// JSON is padded with whitespace, as the original lexer reads past the end of input otherwise.
+/// Inputs with unterminated strings are skipped for the same reason.
+///
+/// @param  name    Name of input (for reporting).
+/// @param  json    JSON to lex.
+/// @param  length  Length of JSON (in chars).
+///
+/// @return  Non-zero if token streams match (or input is skipped); '0' otherwise.
+static int DoTokenStreamsMatchReference(const char* name, const char* json, const int length)
+{
+  csmJsonToken* tape, * expectedTape, * referenceTape;
+  int l, c, tokenCount, expectedCount, referenceCount, quoteCount, paddedLength, doMatch;
+  char* copy;
+
+
+  // Skip inputs with unterminated strings.
+  for (c = 0, quoteCount = 0; c < length; ++c)
+  {
+    quoteCount += (json[c] == '"');
+  }
+
+
+  if (quoteCount % 2)
+  {
+    ++ReferenceSkipCount;
+
+
+    return 1;
+  }
+
+
+  paddedLength = length + ReferencePadding;
+  copy = malloc((size_t)paddedLength + 1);
+  tape = malloc(sizeof(csmJsonToken) * ((size_t)paddedLength + 1));
+  expectedTape = malloc(sizeof(csmJsonToken) * ((size_t)paddedLength + 1));
+  referenceTape = malloc(sizeof(csmJsonToken) * ((size_t)paddedLength + 1));
+
+
+  memcpy(copy, json, (size_t)length);
+  memset(copy + length, ' ', (size_t)ReferencePadding);
+
+
+  copy[paddedLength] = '\0';
+
+
+  referenceCount = ReferenceLexJsonIntoTape(copy, referenceTape, paddedLength + 1);
+  doMatch = 1;
+
+
+  for (l = 0; l < LexerCount; ++l)
+  {
+    tokenCount = Lexers[l](copy, (unsigned int)paddedLength, tape, paddedLength + 1);
+    expectedCount = ConvertToReferenceTokens(copy, tape, tokenCount, expectedTape);
+
+
+    if (expectedCount < 0)
+    {
+      ++ReferenceSkipCount;
+
+
+      break;
+    }
+
+
+    if (expectedCount != referenceCount || memcmp(expectedTape, referenceTape, sizeof(csmJsonToken) * (size_t)referenceCount))
+    {
+      printf("Token stream of %s (%d chars) differs from original lexer with %s lexer.\n", name, length, LexerNames[l]);
+
+
+      doMatch = 0;
+    }
+  }
+
+
+  ReferenceComparisonCount += (expectedCount >= 0);
+
+
+  free(referenceTape);
+  free(expectedTape);
+  free(tape);
+  free(copy);
+
+
+  return doMatch;
+}
+
+/// Compares token streams of all prefixes of JSON (so that every token ends up at the end of input once).
+///
+/// @param  name    Name of input (for reporting).
+/// @param  json    JSON to lex.
+/// @param  length  Length of JSON (in chars).
+///
+/// @return  Number of mismatching prefixes.
+static int CountMismatchingPrefixes(const char* name, const char* json, const int length)
+{
+  int l, mismatchCount;
+
+
+  mismatchCount = 0;
+
+
+  for (l = 0; l <= length; ++l)
+  {
+    mismatchCount += !DoTokenStreamsMatch(name, json, l);
+  }
+
+
+  return mismatchCount;
+}
+
+
+/// Compares token streams of a JSON file.
+///
+/// @param  path  Path to file.
+///
+/// @return  Number of mismatching prefixes ('1' if file can't be read).
+static int TestFile(const char* path)
+{
+  int length, mismatchCount;
+  char* json;
+  FILE* file;
+
+
+  file = fopen(path, "rb");
+
+
+  if (!file)
+  {
+    printf("Failed to open %s.\n", path);
+
+
+    return 1;
+  }
+
+
+  fseek(file, 0, SEEK_END);
+
+
+  length = (int)ftell(file);
+  json = malloc((size_t)length + 1);
+
+
+  fseek(file, 0, SEEK_SET);
+
+
+  length = (int)fread(json, 1, (size_t)length, file);
+
+
+  fclose(file);
+
+
+  mismatchCount = CountMismatchingPrefixes(path, json, length)
+    + !DoTokenStreamsMatchReference(path, json, length);
+
+
+  free(json);
+
+
+  return mismatchCount;
+}
+
+/// Compares token streams of snippets placed at every offset within a SIMD block.
+///
+/// @return  Number of mismatching inputs.
+static int TestSnippets(void)
+{
+  char json[256], name[64];
+  int s, o, f, length, mismatchCount;
+
+
+  mismatchCount = 0;
+
+
+  for (s = 0; s < (int)(sizeof(Snippets) / sizeof(Snippets[0])); ++s)
+  {
+    for (f = 0; Fillers[f]; ++f)
+    {
+      for (o = 0; o < OffsetCount; ++o)
+      {
+        // Put snippet behind filler, and then repeat it right behind the next block boundary.
+        memset(json, Fillers[f], sizeof(json));
+        memcpy(json + o, Snippets[s], strlen(Snippets[s]));
+
+
+        length = o + (int)strlen(Snippets[s]);
+
+
+        memcpy(json + OffsetCount + o, Snippets[s], strlen(Snippets[s]));
+
+
+        sprintf(name, "snippet %d with filler %d at %d", s, f, o);
+
+
+        mismatchCount += CountMismatchingPrefixes(name, json, length)
+          + !DoTokenStreamsMatch(name, json, OffsetCount + length)
+          + !DoTokenStreamsMatchReference(name, json, OffsetCount + length);
+      }
+    }
+  }
+
+
+  return mismatchCount;
+}
+
+/// Compares token streams of random documents.
+///
+/// @return  Number of mismatching inputs.
+static int TestDocuments(void)
+{
+  char chars[1024], name[64];
+  int d, mismatchCount;
+  JsonBuffer buffer;
+
+
+  mismatchCount = 0;
+
+
+  for (d = 0; d < DocumentCount; ++d)
+  {
+    buffer.Chars = chars;
+    buffer.Length = 0;
+    buffer.Capacity = (int)sizeof(chars);
+
+
+    AppendValue(&buffer, 0);
+
+
+    sprintf(name, "document %d", d);
+
+
+    mismatchCount += CountMismatchingPrefixes(name, buffer.Chars, buffer.Length)
+      + !DoTokenStreamsMatchReference(name, buffer.Chars, buffer.Length);
+  }
+
+
+  return mismatchCount;
+}
+
+/// Checks intended differences to the original lexer.
+///
+/// @return  Number of intended differences not met.
+static int TestIntendedDifferences(void)
+{
+  csmJsonToken tape[16], expectedTape[16];
+  int d, l, tokenCount, expectedCount, mismatchCount;
+  const IntendedDifference* difference;
+
+
+  mismatchCount = 0;
+
+
+  for (d = 0; d < (int)(sizeof(IntendedDifferences) / sizeof(IntendedDifferences[0])); ++d)
+  {
+    difference = IntendedDifferences + d;
+
+
+    for (l = 0; l < LexerCount; ++l)
+    {
+      tokenCount = Lexers[l](difference->Json, (unsigned int)strlen(difference->Json), tape, 16);
+
+
+      if (tokenCount != difference->TokenCount || memcmp(tape, difference->Tokens, sizeof(csmJsonToken) * (size_t)tokenCount))
+      {
+        printf("Intended difference not met by %s lexer: %s\n", LexerNames[l], difference->Description);
+
+
+        ++mismatchCount;
+      }
+    }
+
+
+    // Make sure original lexer (and conversion of token streams to it) really differs as described.
+    if (difference->ReferenceTokenCount < 0)
+    {
+      continue;
+    }
+
+
+    tokenCount = ReferenceLexJsonIntoTape(difference->Json, tape, 16);
+    expectedCount = ConvertToReferenceTokens(difference->Json, difference->Tokens, difference->TokenCount, expectedTape);
+
+
+    if (tokenCount != difference->ReferenceTokenCount || memcmp(tape, difference->ReferenceTokens, sizeof(csmJsonToken) * (size_t)tokenCount)
+      || expectedCount != tokenCount || memcmp(expectedTape, tape, sizeof(csmJsonToken) * (size_t)tokenCount))
+    {
+      printf("Intended difference not found in original lexer: %s\n", difference->Description);
+
+
+      ++mismatchCount;
+    }
+  }
+
+
+  return mismatchCount;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+/// Compares the token streams of the SIMD and scalar JSON lexers with each other and with the original lexer.
+///
+/// @param  argc  Number of arguments.
+/// @param  argv  Paths to JSON files to lex in addition to generated JSON.
+///
+/// @return  '0' if all token streams match; '1' otherwise.
+int main(int argc, char** argv)
+{
+  int a, mismatchCount;
+
+
+  mismatchCount = TestIntendedDifferences() + TestSnippets() + TestDocuments();
+
+
+  for (a = 1; a < argc; ++a)
+  {
+    mismatchCount += TestFile(argv[a]);
+  }
+
+
+  printf("Compared %d inputs with original lexer (skipped %d it loses track of).\n", ReferenceComparisonCount, ReferenceSkipCount);
+
+
+  if (mismatchCount)
+  {
+    printf("%d inputs lexed differently.\n", mismatchCount);
+
+
+    return 1;
+  }
+
+
+  printf("All inputs lexed identically.\n");
+
+
+  return 0;
+}
@@ -0,0 +1,458 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Local.h"
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include <Live2DCubismCore.h>
+#include <Live2DCubismFramework.h>
+#include <Live2DCubismFrameworkINTERNAL.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Allocates memory for framework.
+///
+/// @param  size  Number of bytes to allocate.
+///
+/// @return  Valid address on success; '0' otherwise.
+static void* Allocate(const unsigned int size)
+{
+  return malloc(size);
+}
+
+/// Frees memory allocated with 'Allocate'.
+///
+/// @param  memory  Memory to free.
+static void Deallocate(void* memory)
+{
+  free(memory);
+}
+
+
+/// Checks whether a string ends with a suffix.
+///
+/// @param  string  String to check.
+/// @param  suffix  Suffix to match.
+///
+/// @return  Non-zero if suffix matches; '0' otherwise.
+static int EndsWith(const char* string, const char* suffix)
+{
+  size_t stringLength, suffixLength;
+
+
+  stringLength = strlen(string);
+  suffixLength = strlen(suffix);
+
+
+  return stringLength >= suffixLength && strcmp(string + stringLength - suffixLength, suffix) == 0;
+}
+
+
+/// Reads a whole file.
+///
+/// @param  path  Path to file.
+/// @param  size  Size of file (in bytes).
+///
+/// @return  File contents on success; '0' otherwise. Free with 'free'.
+static char* ReadFile(const char* path, unsigned int* size)
+{
+  FILE* file;
+  char* contents;
+  long length;
+
+
+  file = fopen(path, "rb");
+
+
+  if (!file)
+  {
+    return 0;
+  }
+
+
+  // Get size in bytes.
+  if (fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+  {
+    fclose(file);
+
+
+    return 0;
+  }
+
+
+  // Read file into memory and close it afterwards.
+  contents = (char*)malloc((size_t)length + 1);
+
+
+  if (contents && fread(contents, 1, (size_t)length, file) != (size_t)length)
+  {
+    free(contents);
+
+
+    contents = 0;
+  }
+
+
+  fclose(file);
+
+
+  // Store size.
+  *size = (unsigned int)length;
+
+
+  return contents;
+}
+
+/// Writes a whole file.
+///
+/// @param  path      Path to file.
+/// @param  contents  Data to write.
+/// @param  size      Number of bytes to write.
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int WriteFile(const char* path, const void* contents, const unsigned int size)
+{
+  FILE* file;
+  int succeeded;
+
+
+  file = fopen(path, "wb");
+
+
+  if (!file)
+  {
+    return 0;
+  }
+
+
+  succeeded = fwrite(contents, 1, size, file) == size;
+  succeeded = (fclose(file) == 0) && succeeded;
+
+
+  return succeeded;
+}
+
+
+/// Gets type of a segment.
+///
+/// @param  segment  Segment to query.
+///
+/// @return  Segment type.
+static int GetAnimationSegmentType(const csmAnimationSegment* segment)
+{
+  return (int)(segment->TypeAndBasePointIndex >> csmAnimationSegmentTypeShift);
+}
+
+/// Gets index of first point of a segment.
+///
+/// @param  segment  Segment to query.
+///
+/// @return  Index of first segment point.
+static int GetAnimationSegmentBasePointIndex(const csmAnimationSegment* segment)
+{
+  return (int)(segment->TypeAndBasePointIndex & csmAnimationSegmentBasePointIndexMask);
+}
+
+
+/// Checks whether an animation can be evaluated safely.
+///
+/// Animation blobs are used in place by the runtime without checking segments,
+/// so all that checking happens here.
+///
+/// @param  animation  Animation to check.
+///
+/// @return  Non-zero if animation is valid; '0' otherwise.
+static int IsAnimationValid(const csmAnimation* animation)
+{
+  const csmAnimationCurve* curves;
+  const csmAnimationSegment* segments;
+  const csmAnimationPoint* points;
+  int c, s, p, pointCount, bezierCount, lastPointIndex;
+
+
+  if (!(animation->Duration >= 0.0f) || animation->CurveCount < 0 || animation->TotalBezierCount < 0)
+  {
+    return 0;
+  }
+
+
+  curves = (const csmAnimationCurve*)((const char*)animation + animation->CurvesOffset);
+  segments = (const csmAnimationSegment*)((const char*)animation + animation->SegmentsOffset);
+  points = (const csmAnimationPoint*)((const char*)animation + animation->PointsOffset);
+
+
+  // Make sure all curves reference existing segments (sharing points like in motion JSONs) and polynomials...
+  for (c = 0; c < animation->CurveCount; ++c)
+  {
+    if (curves[c].SegmentCount < 1
+      || curves[c].BaseSegmentIndex < 0
+      || curves[c].SegmentCount > (animation->TotalSegmentCount - curves[c].BaseSegmentIndex)
+      || curves[c].BaseBezierIndex < 0)
+    {
+      return 0;
+    }
+
+
+    bezierCount = 0;
+    lastPointIndex = GetAnimationSegmentBasePointIndex(segments + curves[c].BaseSegmentIndex);
+
+
+    for (s = curves[c].BaseSegmentIndex; s < (curves[c].BaseSegmentIndex + curves[c].SegmentCount); ++s)
+    {
+      if (GetAnimationSegmentBasePointIndex(segments + s) != lastPointIndex)
+      {
+        return 0;
+      }
+
+
+      pointCount = (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+        ? 4
+        : 2;
+
+
+      lastPointIndex += pointCount - 1;
+      bezierCount += (pointCount == 4);
+    }
+
+
+    if (bezierCount > (animation->TotalBezierCount - curves[c].BaseBezierIndex))
+    {
+      return 0;
+    }
+  }
+
+
+  // ... all segments reference existing points...
+  for (s = 0; s < animation->TotalSegmentCount; ++s)
+  {
+    pointCount = (GetAnimationSegmentType(segments + s) == csmBezierAnimationSegment)
+      ? 4
+      : 2;
+
+
+    if (pointCount > (animation->TotalPointCount - GetAnimationSegmentBasePointIndex(segments + s)))
+    {
+      return 0;
+    }
+  }
+
+
+  // ... and all points are numbers.
+  for (p = 0; p < animation->TotalPointCount; ++p)
+  {
+    if (!isfinite(points[p].Time) || !isfinite(points[p].Value))
+    {
+      return 0;
+    }
+  }
+
+
+  return 1;
+}
+
+
+/// Bakes a motion.
+///
+/// @param  job     Job to execute.
+/// @param  json    Motion JSON.
+/// @param  length  Length of JSON (in chars).
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int BakeMotion(BakeJob* job, const char* json, const unsigned int length)
+{
+  csmAnimation* animation;
+  void* blob;
+  int succeeded;
+
+
+  animation = csmDeserializeAnimationWithLength(json, length, Allocate, Deallocate);
+
+
+  if (!animation)
+  {
+    return 0;
+  }
+
+
+  succeeded = 0;
+  blob = 0;
+
+
+  if (IsAnimationValid(animation))
+  {
+    job->BlobSize = csmGetSerializedSizeofAnimation(animation);
+    blob = malloc(job->BlobSize);
+  }
+
+
+  // Make sure blob loads before writing it.
+  if (blob && csmSerializeAnimation(animation, blob, job->BlobSize) && csmLoadAnimationFromBlob(blob, job->BlobSize))
+  {
+    // Animations are used in place, so blob is all memory they need.
+    job->DeserializedSize = job->BlobSize;
+
+
+    succeeded = WriteFile(job->OutputPath, blob, job->BlobSize);
+  }
+
+
+  free(blob);
+  free(animation);
+
+
+  return succeeded;
+}
+
+/// Bakes physics.
+///
+/// @param  job     Job to execute.
+/// @param  json    Physics JSON.
+/// @param  length  Length of JSON (in chars).
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int BakePhysics(BakeJob* job, const char* json, const unsigned int length)
+{
+  csmPhysicsRig* physics;
+  void* blob, * rig;
+  int succeeded;
+
+
+  physics = csmDeserializePhysicsWithLength(json, length, Allocate, Deallocate);
+
+
+  if (!physics)
+  {
+    return 0;
+  }
+
+
+  succeeded = 0;
+  rig = 0;
+
+
+  job->BlobSize = csmGetSerializedSizeofPhysics(physics);
+  blob = (job->BlobSize)
+    ? malloc(job->BlobSize)
+    : 0;
+
+
+  if (blob && csmSerializePhysics(physics, blob, job->BlobSize))
+  {
+    job->DeserializedSize = csmGetDeserializedSizeofPhysicsFromBlob(blob, job->BlobSize);
+    rig = (job->DeserializedSize)
+      ? malloc(job->DeserializedSize)
+      : 0;
+  }
+
+
+  // Make sure blob loads (which also validates sub rigs) before writing it.
+  if (rig && csmLoadPhysicsFromBlobInPlace(blob, job->BlobSize, rig, job->DeserializedSize))
+  {
+    succeeded = WriteFile(job->OutputPath, blob, job->BlobSize);
+  }
+
+
+  free(rig);
+  free(blob);
+  free(physics);
+
+
+  return succeeded;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+AssetKind GetAssetKind(const char* path)
+{
+  if (EndsWith(path, GetJsonSuffix(MotionAsset)))
+  {
+    return MotionAsset;
+  }
+
+
+  if (EndsWith(path, GetJsonSuffix(PhysicsAsset)))
+  {
+    return PhysicsAsset;
+  }
+
+
+  return UnknownAsset;
+}
+
+const char* GetBlobExtension(const AssetKind kind)
+{
+  return (kind == MotionAsset)
+    ? ".canm"
+    : ".cphy";
+}
+
+const char* GetJsonSuffix(const AssetKind kind)
+{
+  return (kind == MotionAsset)
+    ? ".motion3.json"
+    : ".physics3.json";
+}
+
+
+int Bake(BakeJob* job)
+{
+  const char* json;
+  char* contents;
+  unsigned int length;
+
+
+  job->Succeeded = 0;
+  job->BlobSize = 0;
+  job->DeserializedSize = 0;
+
+
+  contents = ReadFile(job->InputPath, &length);
+
+
+  if (!contents)
+  {
+    return 0;
+  }
+
+
+  // Skip byte order mark some editors prepend.
+  json = contents;
+
+
+  if (length >= 3 && memcmp(json, "\xEF\xBB\xBF", 3) == 0)
+  {
+    json += 3;
+    length -= 3;
+  }
+
+
+  job->Succeeded = (job->Kind == MotionAsset)
+    ? BakeMotion(job, json, length)
+    : BakePhysics(job, json, length);
+
+
+  free(contents);
+
+
+  return job->Succeeded;
+}
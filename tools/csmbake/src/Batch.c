@@ -0,0 +1,508 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Local.h"
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if _USE_PTHREADS
+  #include <pthread.h>
+#endif
+
+
+// ----- //
+// TYPES //
+// ----- //
+
+/// Growable list of jobs.
+typedef struct JobList
+{
+  /// Jobs.
+  BakeJob* Jobs;
+
+  /// Number of jobs.
+  int Count;
+
+  /// Number of jobs memory is reserved for.
+  int Capacity;
+}
+JobList;
+
+
+/// Job queue shared by worker threads.
+typedef struct JobQueue
+{
+  /// Jobs to run.
+  BakeJob* Jobs;
+
+  /// Number of jobs.
+  int Count;
+
+  /// Index of next job to run.
+  int Next;
+
+#if _USE_PTHREADS
+  /// Lock guarding 'Next'.
+  pthread_mutex_t Lock;
+#endif
+}
+JobQueue;
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Joins two paths.
+///
+/// @param  directory   Directory path.
+/// @param  name        Name to append.
+/// @param  nameLength  Number of chars of name to append.
+/// @param  suffix      Suffix to append.
+///
+/// @return  Joined path on success; '0' otherwise. Free with 'free'.
+static char* JoinPath(const char* directory, const char* name, const size_t nameLength, const char* suffix)
+{
+  size_t directoryLength, suffixLength;
+  char* path;
+
+
+  directoryLength = strlen(directory);
+  suffixLength = strlen(suffix);
+
+
+  path = (char*)malloc(directoryLength + 1 + nameLength + suffixLength + 1);
+
+
+  if (!path)
+  {
+    return 0;
+  }
+
+
+  memcpy(path, directory, directoryLength);
+  path[directoryLength] = '/';
+  memcpy(path + directoryLength + 1, name, nameLength);
+  memcpy(path + directoryLength + 1 + nameLength, suffix, suffixLength);
+  path[directoryLength + 1 + nameLength + suffixLength] = '\0';
+
+
+  return path;
+}
+
+/// Creates a directory if it doesn't exist yet.
+///
+/// @param  path  Directory to create.
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int MakeDirectory(const char* path)
+{
+  return mkdir(path, 0777) == 0 || errno == EEXIST;
+}
+
+
+/// Adds a job to a list.
+///
+/// @param  list             List to add to.
+/// @param  kind             Kind of asset.
+/// @param  inputPath        Path to JSON (owned by list afterwards).
+/// @param  outputDirectory  Directory to write blob to.
+/// @param  name             File name of JSON.
+/// @param  relativeOffset   Offset into output path of path relative to output root (in chars).
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int AddJob(JobList* list, const AssetKind kind, char* inputPath, const char* outputDirectory, const char* name, const size_t relativeOffset)
+{
+  BakeJob* jobs;
+  BakeJob* job;
+  int capacity;
+
+
+  // Grow list if necessary.
+  if (list->Count == list->Capacity)
+  {
+    capacity = (list->Capacity)
+      ? (list->Capacity * 2)
+      : 64;
+    jobs = (BakeJob*)realloc(list->Jobs, sizeof(BakeJob) * (size_t)capacity);
+
+
+    if (!jobs)
+    {
+      free(inputPath);
+
+
+      return 0;
+    }
+
+
+    list->Jobs = jobs;
+    list->Capacity = capacity;
+  }
+
+
+  job = &list->Jobs[list->Count];
+
+
+  // Replace '.json' with blob extension (keeping e.g. '.motion3').
+  job->Kind = kind;
+  job->InputPath = inputPath;
+  job->OutputPath = JoinPath(outputDirectory, name, strlen(name) - strlen(".json"), GetBlobExtension(kind));
+
+
+  if (!job->OutputPath)
+  {
+    free(inputPath);
+
+
+    return 0;
+  }
+
+
+  job->RelativeOutputPath = job->OutputPath + relativeOffset;
+  job->BlobSize = 0;
+  job->DeserializedSize = 0;
+  job->Succeeded = 0;
+
+
+  ++list->Count;
+
+
+  return 1;
+}
+
+/// Collects jobs in directory tree.
+///
+/// @param  list             List to add jobs to.
+/// @param  inputDirectory   Directory to search.
+/// @param  outputDirectory  Directory to mirror tree in.
+/// @param  relativeOffset   Offset into output paths of paths relative to output root (in chars).
+///
+/// @return  Non-zero on success; '0' otherwise.
+static int CollectJobsInDirectory(JobList* list, const char* inputDirectory, const char* outputDirectory, const size_t relativeOffset)
+{
+  struct dirent* entry;
+  struct stat info;
+  AssetKind kind;
+  char* inputPath, * outputPath;
+  DIR* directory;
+  int succeeded;
+
+
+  directory = opendir(inputDirectory);
+
+
+  if (!directory)
+  {
+    fprintf(stderr, "Failed to open directory '%s'.\n", inputDirectory);
+
+
+    return 0;
+  }
+
+
+  succeeded = 1;
+
+
+  while (succeeded && (entry = readdir(directory)) != 0)
+  {
+    // Skip hidden entries (including '.' and '..').
+    if (entry->d_name[0] == '.')
+    {
+      continue;
+    }
+
+
+    inputPath = JoinPath(inputDirectory, entry->d_name, strlen(entry->d_name), "");
+
+
+    if (!inputPath || stat(inputPath, &info) != 0)
+    {
+      free(inputPath);
+
+
+      continue;
+    }
+
+
+    // Recurse into directories...
+    if (S_ISDIR(info.st_mode))
+    {
+      outputPath = JoinPath(outputDirectory, entry->d_name, strlen(entry->d_name), "");
+      succeeded = outputPath
+        && MakeDirectory(outputPath)
+        && CollectJobsInDirectory(list, inputPath, outputPath, relativeOffset);
+
+
+      free(outputPath);
+      free(inputPath);
+
+
+      continue;
+    }
+
+
+    // ... and collect assets.
+    kind = GetAssetKind(entry->d_name);
+
+
+    if (kind == UnknownAsset)
+    {
+      free(inputPath);
+
+
+      continue;
+    }
+
+
+    succeeded = AddJob(list, kind, inputPath, outputDirectory, entry->d_name, relativeOffset);
+  }
+
+
+  closedir(directory);
+
+
+  return succeeded;
+}
+
+
+/// Compares jobs by input path.
+///
+/// @param  a  First job.
+/// @param  b  Second job.
+///
+/// @return  Comparison result as expected by 'qsort'.
+static int CompareJobs(const void* a, const void* b)
+{
+  return strcmp(((const BakeJob*)a)->InputPath, ((const BakeJob*)b)->InputPath);
+}
+
+
+/// Runs jobs from queue until it is empty.
+///
+/// @param  jobQueue  Queue to drain.
+///
+/// @return  Always '0'.
+static void* DrainJobQueue(void* jobQueue)
+{
+  JobQueue* queue;
+  int index;
+
+
+  queue = (JobQueue*)jobQueue;
+
+
+  for (;;)
+  {
+#if _USE_PTHREADS
+    pthread_mutex_lock(&queue->Lock);
+#endif
+
+    index = queue->Next++;
+
+#if _USE_PTHREADS
+    pthread_mutex_unlock(&queue->Lock);
+#endif
+
+
+    if (index >= queue->Count)
+    {
+      break;
+    }
+
+
+    if (!Bake(&queue->Jobs[index]))
+    {
+      fprintf(stderr, "Failed to bake '%s'.\n", queue->Jobs[index].InputPath);
+    }
+  }
+
+
+  return 0;
+}
+
+
+// -------------- //
+// IMPLEMENTATION //
+// -------------- //
+
+int CollectJobs(const char* inputDirectory, const char* outputDirectory, BakeJob** jobs, int* jobCount)
+{
+  JobList list;
+  int succeeded;
+
+
+  list.Jobs = 0;
+  list.Count = 0;
+  list.Capacity = 0;
+
+
+  succeeded = MakeDirectory(outputDirectory)
+    && CollectJobsInDirectory(&list, inputDirectory, outputDirectory, strlen(outputDirectory) + 1);
+
+
+  if (!succeeded)
+  {
+    fprintf(stderr, "Failed to collect assets in '%s'.\n", inputDirectory);
+
+
+    ReleaseJobs(list.Jobs, list.Count);
+
+
+    return 0;
+  }
+
+
+  // Sort jobs so that manifests don't depend on directory order.
+  if (list.Count)
+  {
+    qsort(list.Jobs, (size_t)list.Count, sizeof(BakeJob), CompareJobs);
+  }
+
+
+  *jobs = list.Jobs;
+  *jobCount = list.Count;
+
+
+  return 1;
+}
+
+void RunJobs(BakeJob* jobs, const int jobCount, const int threadCount)
+{
+  JobQueue queue;
+#if _USE_PTHREADS
+  pthread_t* threads;
+  int t, startedThreadCount;
+#endif
+
+
+  queue.Jobs = jobs;
+  queue.Count = jobCount;
+  queue.Next = 0;
+
+
+#if _USE_PTHREADS
+  threads = (threadCount > 1)
+    ? (pthread_t*)malloc(sizeof(pthread_t) * (size_t)(threadCount - 1))
+    : 0;
+
+
+  pthread_mutex_init(&queue.Lock, 0);
+
+
+  // Spawn helpers...
+  startedThreadCount = 0;
+
+
+  for (t = 0; threads && t < (threadCount - 1); ++t)
+  {
+    if (pthread_create(&threads[startedThreadCount], 0, DrainJobQueue, &queue) == 0)
+    {
+      ++startedThreadCount;
+    }
+  }
+
+
+  // ... and work on calling thread, too.
+  DrainJobQueue(&queue);
+
+
+  for (t = 0; t < startedThreadCount; ++t)
+  {
+    pthread_join(threads[t], 0);
+  }
+
+
+  pthread_mutex_destroy(&queue.Lock);
+  free(threads);
+#else
+  DrainJobQueue(&queue);
+#endif
+}
+
+int WriteManifest(const char* path, const BakeJob* jobs, const int jobCount)
+{
+  unsigned long long arenaSize;
+  FILE* file;
+  int j;
+
+
+  file = fopen(path, "w");
+
+
+  if (!file)
+  {
+    fprintf(stderr, "Failed to open '%s' for writing.\n", path);
+
+
+    return 0;
+  }
+
+
+  fprintf(file, "# csmbake manifest\n");
+  fprintf(file, "# kind blob-size deserialized-size path\n");
+
+
+  // List blobs...
+  arenaSize = 0;
+
+
+  for (j = 0; j < jobCount; ++j)
+  {
+    if (!jobs[j].Succeeded)
+    {
+      continue;
+    }
+
+
+    fprintf(file, "%s %u %u %s\n",
+            (jobs[j].Kind == MotionAsset)
+              ? "motion"
+              : "physics",
+            jobs[j].BlobSize,
+            jobs[j].DeserializedSize,
+            jobs[j].RelativeOutputPath);
+
+
+    // Keep every asset in arena 16-byte aligned.
+    arenaSize += (jobs[j].DeserializedSize + 15ULL) & ~15ULL;
+  }
+
+
+  // ... and total memory needed to hold all of them.
+  fprintf(file, "arena %llu\n", arenaSize);
+
+
+  return fclose(file) == 0;
+}
+
+void ReleaseJobs(BakeJob* jobs, const int jobCount)
+{
+  int j;
+
+
+  for (j = 0; j < jobCount; ++j)
+  {
+    free(jobs[j].InputPath);
+    free(jobs[j].OutputPath);
+  }
+
+
+  free(jobs);
+}
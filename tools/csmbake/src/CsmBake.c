@@ -0,0 +1,183 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Local.h"
+
+
+// -------- //
+// REQUIRES //
+// -------- //
+
+#include <Live2DCubismCore.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if _USE_PTHREADS
+  #include <unistd.h>
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+/// Name of manifest written to output directory.
+static const char* ManifestName = "manifest.txt";
+
+
+/// Logs Core and framework messages.
+///
+/// @param  message  Message to log.
+static void LogToStandardError(const char* message)
+{
+  fprintf(stderr, "%s\n", message);
+}
+
+
+/// Prints usage.
+static void PrintUsage()
+{
+  fprintf(stderr,
+          "Usage: csmbake [-j <jobs>] <input directory> <output directory>\n"
+          "\n"
+          "Bakes all '*.motion3.json' and '*.physics3.json' files found in input directory (recursively)\n"
+          "into '*.motion3.canm' and '*.physics3.cphy' blobs, mirroring the directory tree in output directory,\n"
+          "and lists all blobs in '<output directory>/manifest.txt'.\n");
+}
+
+
+/// Gets the default number of jobs to run in parallel.
+///
+/// @return  Number of jobs.
+static int GetDefaultJobCount()
+{
+#if _USE_PTHREADS
+  long processorCount;
+
+
+  processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+
+  return (processorCount > 0)
+    ? (int)processorCount
+    : 1;
+#else
+  return 1;
+#endif
+}
+
+
+// ---- //
+// MAIN //
+// ---- //
+
+int main(int argc, char** argv)
+{
+  const char* inputDirectory;
+  const char* outputDirectory;
+  char* manifestPath;
+  BakeJob* jobs;
+  int a, j, jobCount, threadCount, failureCount;
+
+
+  // Parse arguments.
+  inputDirectory = 0;
+  outputDirectory = 0;
+  threadCount = GetDefaultJobCount();
+
+
+  for (a = 1; a < argc; ++a)
+  {
+    if (strcmp(argv[a], "-j") == 0 && (a + 1) < argc)
+    {
+      threadCount = atoi(argv[++a]);
+    }
+    else if (!inputDirectory)
+    {
+      inputDirectory = argv[a];
+    }
+    else if (!outputDirectory)
+    {
+      outputDirectory = argv[a];
+    }
+    else
+    {
+      inputDirectory = 0;
+
+
+      break;
+    }
+  }
+
+
+  if (!inputDirectory || !outputDirectory || threadCount < 1)
+  {
+    PrintUsage();
+
+
+    return EXIT_FAILURE;
+  }
+
+
+  csmSetLogFunction(LogToStandardError);
+
+
+  // Bake assets.
+  if (!CollectJobs(inputDirectory, outputDirectory, &jobs, &jobCount))
+  {
+    return EXIT_FAILURE;
+  }
+
+
+  RunJobs(jobs, jobCount, threadCount);
+
+
+  failureCount = 0;
+
+
+  for (j = 0; j < jobCount; ++j)
+  {
+    failureCount += !jobs[j].Succeeded;
+  }
+
+
+  printf("Baked %d of %d assets.\n", jobCount - failureCount, jobCount);
+
+
+  // Write manifest.
+  manifestPath = (char*)malloc(strlen(outputDirectory) + 1 + strlen(ManifestName) + 1);
+
+
+  if (!manifestPath)
+  {
+    ReleaseJobs(jobs, jobCount);
+
+
+    return EXIT_FAILURE;
+  }
+
+
+  sprintf(manifestPath, "%s/%s", outputDirectory, ManifestName);
+
+
+  if (!WriteManifest(manifestPath, jobs, jobCount))
+  {
+    ++failureCount;
+  }
+
+
+  free(manifestPath);
+  ReleaseJobs(jobs, jobCount);
+
+
+  return (failureCount)
+    ? EXIT_FAILURE
+    : EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at http://live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+
+// ----- //
+// TYPES //
+// ----- //
+
+/// Kinds of assets that can be baked.
+typedef enum AssetKind
+{
+  /// Asset that isn't baked.
+  UnknownAsset,
+
+  /// Motion (baked with 'csmSerializeAnimation').
+  MotionAsset,
+
+  /// Physics (baked with 'csmSerializePhysics').
+  PhysicsAsset
+}
+AssetKind;
+
+
+/// Single asset to bake.
+typedef struct BakeJob
+{
+  /// Kind of asset.
+  AssetKind Kind;
+
+  /// Path of JSON to read.
+  char* InputPath;
+
+  /// Path of blob to write.
+  char* OutputPath;
+
+  /// Path of blob relative to output directory (points into 'OutputPath').
+  const char* RelativeOutputPath;
+
+
+  /// Size of written blob (in bytes).
+  unsigned int BlobSize;
+
+  /// Size of asset in memory after loading blob (in bytes).
+  unsigned int DeserializedSize;
+
+  /// Non-zero if asset was baked successfully.
+  int Succeeded;
+}
+BakeJob;
+
+
+// ---- //
+// BAKE //
+// ---- //
+
+/// Gets the kind of an asset by its file name.
+///
+/// @param  path  Path to asset.
+///
+/// @return  Kind of asset.
+AssetKind GetAssetKind(const char* path);
+
+/// Gets the file name extension of blobs.
+///
+/// @param  kind  Kind of asset.
+///
+/// @return  Extension including leading dot.
+const char* GetBlobExtension(const AssetKind kind);
+
+/// Gets the suffix of JSON files by kind.
+///
+/// @param  kind  Kind of asset.
+///
+/// @return  Suffix including leading dot.
+const char* GetJsonSuffix(const AssetKind kind);
+
+
+/// Bakes an asset.
+///
+/// Results are written to the job.
+/// The function doesn't touch any global state, so jobs can be run in parallel.
+///
+/// @param  job  Job to execute.
+///
+/// @return  Non-zero on success; '0' otherwise.
+int Bake(BakeJob* job);
+
+
+// ----- //
+// BATCH //
+// ----- //
+
+/// Collects all bakeable assets in a directory tree, sorted by path.
+///
+/// Output directories are created as necessary.
+///
+/// @param  inputDirectory   Directory to search.
+/// @param  outputDirectory  Directory to mirror tree in.
+/// @param  jobs             Collected jobs. Release with 'ReleaseJobs'.
+/// @param  jobCount         Number of jobs collected.
+///
+/// @return  Non-zero on success; '0' otherwise.
+int CollectJobs(const char* inputDirectory, const char* outputDirectory, BakeJob** jobs, int* jobCount);
+
+/// Runs jobs.
+///
+/// @param  jobs         Jobs to run.
+/// @param  jobCount     Number of jobs.
+/// @param  threadCount  Maximum number of jobs to run in parallel.
+void RunJobs(BakeJob* jobs, const int jobCount, const int threadCount);
+
+/// Writes manifest of successfully baked jobs.
+///
+/// @param  path      Path of manifest.
+/// @param  jobs      Jobs to list.
+/// @param  jobCount  Number of jobs.
+///
+/// @return  Non-zero on success; '0' otherwise.
+int WriteManifest(const char* path, const BakeJob* jobs, const int jobCount);
+
+/// Releases jobs.
+///
+/// @param  jobs      Jobs to release.
+/// @param  jobCount  Number of jobs.
+void ReleaseJobs(BakeJob* jobs, const int jobCount);